@@ -0,0 +1,510 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+#endif
+#include "fossil/xpattern/contract.h"
+#include "fossil/xpattern/contract_sample.h"
+#include "fossil/xpattern/contract_span.h"
+#include "fossil/xpattern/lazy.h"
+#include "fossil/xpattern/observer.h"
+#include "fossil/xpattern/observer_typed.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef FSCL_XPATTERN_VERSION
+#define FSCL_XPATTERN_VERSION "unknown"
+#endif
+
+// Benchmark driver for the observer, lazy and contract hot paths.
+//
+// Every benchmark is calibrated to a batch of iterations that takes at least
+// --batch-us, warmed up for --warmup batches and then measured for
+// --repetitions batches. Each batch yields one ns/op sample; the JSON report
+// carries min, mean, percentiles and max over those samples so two runs can
+// be compared entry by entry.
+
+typedef struct {
+    const char *group;
+    const char *name;
+    size_t param;  // Problem size, e.g. observer count
+    void *(*setup)(size_t param);
+    void (*run)(void *state, size_t iterations);
+    void (*teardown)(void *state);
+} bench_case;
+
+typedef struct {
+    size_t repetitions;
+    size_t warmup;
+    unsigned long long batch_ns;
+    const char *filter;
+    const char *output;
+} bench_config;
+
+typedef struct {
+    size_t iterations;
+    double min;
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+} bench_result;
+
+// Keeps measured work observable so the compiler cannot drop it
+static volatile long long bench_sink;
+
+static unsigned long long bench_now_ns(void) {
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (unsigned long long)(counter.QuadPart / frequency.QuadPart) * 1000000000ULL +
+           (unsigned long long)(counter.QuadPart % frequency.QuadPart) * 1000000000ULL / (unsigned long long)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+// =================================================================
+// Observer
+// =================================================================
+
+typedef struct {
+    csubject subject;
+    cobserver *observers;
+    cobserver extra;
+    size_t count;
+} observer_state;
+
+static void observer_update(void *data) {
+    bench_sink += *(int *)data;
+}
+
+static void *observer_setup(size_t param) {
+    observer_state *state = malloc(sizeof(observer_state));
+    if (state == NULL) {
+        return NULL;
+    }
+    state->observers = calloc(param ? param : 1, sizeof(cobserver));
+    if (state->observers == NULL) {
+        free(state);
+        return NULL;
+    }
+    state->count = param;
+    state->extra = (cobserver){ observer_update };
+    fscl_observe_create(&state->subject);
+    for (size_t i = 0; i < param; ++i) {
+        state->observers[i].update = observer_update;
+        fscl_observe_add_observer(&state->subject, &state->observers[i]);
+    }
+    return state;
+}
+
+static void observer_teardown(void *arg) {
+    observer_state *state = arg;
+    fscl_observe_erase(&state->subject);
+    free(state->observers);
+    free(state);
+}
+
+static void observer_notify_run(void *arg, size_t iterations) {
+    observer_state *state = arg;
+    int value = 1;
+    for (size_t i = 0; i < iterations; ++i) {
+        fscl_observe_notify(&state->subject, &value);
+    }
+}
+
+FSCL_OBSERVE_DECLARE_FIXED_VALUE(bench_typed, int, 512)
+
+static void observer_typed_update(void *context, int value) {
+    (void)context;
+    bench_sink += value;
+}
+
+static void *observer_typed_setup(size_t param) {
+    bench_typed_subject *subject = malloc(sizeof(bench_typed_subject));
+    if (subject == NULL) {
+        return NULL;
+    }
+    bench_typed_create(subject);
+    for (size_t i = 0; i < param; ++i) {
+        bench_typed_add(subject, observer_typed_update, NULL);
+    }
+    return subject;
+}
+
+static void observer_typed_teardown(void *arg) {
+    free(arg);
+}
+
+static void observer_typed_run(void *arg, size_t iterations) {
+    const bench_typed_subject *subject = arg;
+    for (size_t i = 0; i < iterations; ++i) {
+        bench_typed_notify(subject, 1);
+    }
+}
+
+// Add and remove one observer behind `param` resident ones
+static void observer_churn_run(void *arg, size_t iterations) {
+    observer_state *state = arg;
+    for (size_t i = 0; i < iterations; ++i) {
+        fscl_observe_add_observer(&state->subject, &state->extra);
+        fscl_observe_remove_observer(&state->subject, &state->extra);
+    }
+}
+
+// =================================================================
+// Lazy
+// =================================================================
+
+typedef struct {
+    clazy value;
+    clazy left;
+    clazy right;
+} lazy_state;
+
+static void lazy_int_thunk(clazy *lazy, void *context) {
+    fscl_lazy_set_int(lazy, *(int *)context);
+}
+
+static int lazy_increment(int value) {
+    return value + 1;
+}
+
+static void *lazy_setup(size_t param) {
+    lazy_state *state = malloc(sizeof(lazy_state));
+    if (state == NULL) {
+        return NULL;
+    }
+    char text[64];
+    size_t length = param < sizeof(text) - 1 ? param : sizeof(text) - 1;
+    memset(text, 'x', length);
+    text[length] = '\0';
+
+    state->value = fscl_lazy_create(CLAZY_INT);
+    fscl_lazy_set_int(&state->value, 0);
+    state->left = fscl_lazy_create(CLAZY_STRING);
+    state->right = fscl_lazy_create(CLAZY_STRING);
+    fscl_lazy_set_cstring(&state->left, text);
+    fscl_lazy_set_cstring(&state->right, text);
+    return state;
+}
+
+static void lazy_teardown(void *arg) {
+    lazy_state *state = arg;
+    fscl_lazy_erase(&state->value);
+    fscl_lazy_erase(&state->left);
+    fscl_lazy_erase(&state->right);
+    free(state);
+}
+
+static void lazy_force_run(void *arg, size_t iterations) {
+    (void)arg;
+    int seed = 42;
+    for (size_t i = 0; i < iterations; ++i) {
+        clazy lazy = fscl_lazy_create_thunk(CLAZY_INT, lazy_int_thunk, &seed);
+        bench_sink += fscl_lazy_force_int(&lazy);
+        fscl_lazy_erase(&lazy);
+    }
+}
+
+static void lazy_map_run(void *arg, size_t iterations) {
+    lazy_state *state = arg;
+    for (size_t i = 0; i < iterations; ++i) {
+        fscl_lazy_map_int(&state->value, lazy_increment);
+    }
+    bench_sink += fscl_lazy_force_int(&state->value);
+}
+
+static void lazy_concat_run(void *arg, size_t iterations) {
+    lazy_state *state = arg;
+    for (size_t i = 0; i < iterations; ++i) {
+        clazy result = fscl_lazy_create(CLAZY_STRING);
+        fscl_lazy_concat_cstrings(&result, &state->left, &state->right);
+        bench_sink += result.data.string_value.data[0];
+        fscl_lazy_erase(&result);
+    }
+}
+
+// =================================================================
+// Contract
+// =================================================================
+
+typedef struct {
+    int *values;
+    size_t count;
+} contract_state;
+
+static bool contract_pre_true(void) {
+    return true;
+}
+
+static ccontract contract_static = FSCL_CONTRACT_INIT(contract_pre_true, NULL);
+
+static void *contract_setup(size_t param) {
+    contract_state *state = malloc(sizeof(contract_state));
+    if (state == NULL) {
+        return NULL;
+    }
+    state->count = param;
+    state->values = malloc((param ? param : 1) * sizeof(int));
+    if (state->values == NULL) {
+        free(state);
+        return NULL;
+    }
+    for (size_t i = 0; i < param; ++i) {
+        state->values[i] = (int)(i % 100);
+    }
+    return state;
+}
+
+static void contract_teardown(void *arg) {
+    contract_state *state = arg;
+    free(state->values);
+    free(state);
+}
+
+// Loop and sink cost alone; subtract from the other contract cases
+static void contract_baseline_run(void *arg, size_t iterations) {
+    contract_state *state = arg;
+    for (size_t i = 0; i < iterations; ++i) {
+        bench_sink += state->values[i % state->count];
+    }
+}
+
+static void contract_not_null_run(void *arg, size_t iterations) {
+    contract_state *state = arg;
+    for (size_t i = 0; i < iterations; ++i) {
+        bench_sink += fscl_contract_require_not_null(&state->values[i % state->count], "value");
+    }
+}
+
+static void contract_macro_run(void *arg, size_t iterations) {
+    contract_state *state = arg;
+    for (size_t i = 0; i < iterations; ++i) {
+        bench_sink += FSCL_REQUIRE_WITHIN_RANGE(state->values[i % state->count], 0, 99, "value");
+    }
+}
+
+static void contract_sampled_run(void *arg, size_t iterations) {
+    FSCL_CONTRACT_SITE(site, "bench.sampled", 64);
+    contract_state *state = arg;
+    for (size_t i = 0; i < iterations; ++i) {
+        bench_sink += FSCL_REQUIRE_SAMPLED(&site, state->values[i % state->count] < 100);
+    }
+}
+
+static void contract_check_pre_run(void *arg, size_t iterations) {
+    (void)arg;
+    for (size_t i = 0; i < iterations; ++i) {
+        bench_sink += fscl_contract_check_pre(&contract_static);
+    }
+}
+
+// One op is a whole span of `param` integers
+static void contract_span_run(void *arg, size_t iterations) {
+    contract_state *state = arg;
+    for (size_t i = 0; i < iterations; ++i) {
+        bench_sink += fscl_contract_require_all_within_range(state->values, state->count, 0, 99, "values");
+    }
+}
+
+// =================================================================
+// Driver
+// =================================================================
+
+static const bench_case bench_cases[] = {
+    { "observer", "notify", 1, observer_setup, observer_notify_run, observer_teardown },
+    { "observer", "notify", 8, observer_setup, observer_notify_run, observer_teardown },
+    { "observer", "notify", 64, observer_setup, observer_notify_run, observer_teardown },
+    { "observer", "notify", 512, observer_setup, observer_notify_run, observer_teardown },
+    { "observer", "typed_notify", 8, observer_typed_setup, observer_typed_run, observer_typed_teardown },
+    { "observer", "typed_notify", 64, observer_typed_setup, observer_typed_run, observer_typed_teardown },
+    { "observer", "churn", 0, observer_setup, observer_churn_run, observer_teardown },
+    { "observer", "churn", 64, observer_setup, observer_churn_run, observer_teardown },
+    { "observer", "churn", 512, observer_setup, observer_churn_run, observer_teardown },
+    { "lazy", "force_int", 0, lazy_setup, lazy_force_run, lazy_teardown },
+    { "lazy", "map_int", 0, lazy_setup, lazy_map_run, lazy_teardown },
+    { "lazy", "concat", 8, lazy_setup, lazy_concat_run, lazy_teardown },
+    { "lazy", "concat", 48, lazy_setup, lazy_concat_run, lazy_teardown },
+    { "contract", "baseline", 1024, contract_setup, contract_baseline_run, contract_teardown },
+    { "contract", "require_not_null", 1024, contract_setup, contract_not_null_run, contract_teardown },
+    { "contract", "require_within_range", 1024, contract_setup, contract_macro_run, contract_teardown },
+    { "contract", "require_sampled", 1024, contract_setup, contract_sampled_run, contract_teardown },
+    { "contract", "check_pre", 1024, contract_setup, contract_check_pre_run, contract_teardown },
+    { "contract", "all_within_range", 1024, contract_setup, contract_span_run, contract_teardown },
+};
+
+static int bench_compare(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted samples
+static double bench_percentile(const double *sorted, size_t count, double percent) {
+    size_t rank = (size_t)(percent / 100.0 * (double)count + 0.999999);
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static unsigned long long bench_batch(const bench_case *bench, void *state, size_t iterations) {
+    unsigned long long started = bench_now_ns();
+    bench->run(state, iterations);
+    return bench_now_ns() - started;
+}
+
+static bool bench_measure(const bench_case *bench, const bench_config *config, double *samples, bench_result *result) {
+    void *state = bench->setup(bench->param);
+    if (state == NULL) {
+        return false;
+    }
+
+    // Double the batch until it is long enough to time reliably
+    size_t iterations = 1;
+    while (bench_batch(bench, state, iterations) < config->batch_ns && iterations < ((size_t)1 << 30)) {
+        iterations *= 2;
+    }
+    for (size_t i = 0; i < config->warmup; ++i) {
+        bench_batch(bench, state, iterations);
+    }
+
+    double total = 0.0;
+    for (size_t i = 0; i < config->repetitions; ++i) {
+        samples[i] = (double)bench_batch(bench, state, iterations) / (double)iterations;
+        total += samples[i];
+    }
+    bench->teardown(state);
+
+    qsort(samples, config->repetitions, sizeof(double), bench_compare);
+    result->iterations = iterations;
+    result->min = samples[0];
+    result->mean = total / (double)config->repetitions;
+    result->p50 = bench_percentile(samples, config->repetitions, 50.0);
+    result->p90 = bench_percentile(samples, config->repetitions, 90.0);
+    result->p99 = bench_percentile(samples, config->repetitions, 99.0);
+    result->max = samples[config->repetitions - 1];
+    return true;
+}
+
+static bool bench_selected(const bench_case *bench, const char *filter) {
+    if (filter == NULL) {
+        return true;
+    }
+    char full[128];
+    snprintf(full, sizeof(full), "%s/%s/%zu", bench->group, bench->name, bench->param);
+    return strstr(full, filter) != NULL;
+}
+
+static void bench_usage(const char *program) {
+    fprintf(stderr,
+            "usage: %s [--repetitions N] [--warmup N] [--batch-us N] [--filter TEXT] [--output FILE] [--list]\n",
+            program);
+}
+
+static bool bench_parse_count(const char *text, size_t *value) {
+    char *end = NULL;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || parsed == 0) {
+        return false;
+    }
+    *value = (size_t)parsed;
+    return true;
+}
+
+int main(int argc, char **argv) {
+    bench_config config = { 30, 5, 2000000ULL, NULL, NULL };
+    size_t cases = sizeof(bench_cases) / sizeof(bench_cases[0]);
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        size_t count = 0;
+        if (strcmp(arg, "--list") == 0) {
+            for (size_t c = 0; c < cases; ++c) {
+                printf("%s/%s/%zu\n", bench_cases[c].group, bench_cases[c].name, bench_cases[c].param);
+            }
+            return EXIT_SUCCESS;
+        } else if (value == NULL) {
+            bench_usage(argv[0]);
+            return EXIT_FAILURE;
+        } else if (strcmp(arg, "--repetitions") == 0 && bench_parse_count(value, &count)) {
+            config.repetitions = count;
+        } else if (strcmp(arg, "--warmup") == 0 && (strcmp(value, "0") == 0 || bench_parse_count(value, &count))) {
+            config.warmup = count;
+        } else if (strcmp(arg, "--batch-us") == 0 && bench_parse_count(value, &count)) {
+            config.batch_ns = (unsigned long long)count * 1000ULL;
+        } else if (strcmp(arg, "--filter") == 0) {
+            config.filter = value;
+        } else if (strcmp(arg, "--output") == 0) {
+            config.output = value;
+        } else {
+            bench_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        ++i;
+    }
+
+    FILE *out = config.output != NULL ? fopen(config.output, "w") : stdout;
+    double *samples = malloc(config.repetitions * sizeof(double));
+    if (out == NULL || samples == NULL) {
+        fprintf(stderr, "xbench: cannot open output or allocate samples\n");
+        free(samples);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(out, "{\n  \"suite\": \"fscl-xpattern-c\",\n  \"version\": \"%s\",\n", FSCL_XPATTERN_VERSION);
+    fprintf(out, "  \"contract_level\": %d,\n  \"repetitions\": %zu,\n  \"warmup\": %zu,\n  \"batch_ns\": %llu,\n",
+            FSCL_CONTRACT_LEVEL, config.repetitions, config.warmup, config.batch_ns);
+    fprintf(out, "  \"benchmarks\": [");
+
+    int status = EXIT_SUCCESS;
+    bool first = true;
+    for (size_t c = 0; c < cases; ++c) {
+        const bench_case *bench = &bench_cases[c];
+        if (!bench_selected(bench, config.filter)) {
+            continue;
+        }
+        bench_result result;
+        if (!bench_measure(bench, &config, samples, &result)) {
+            fprintf(stderr, "xbench: %s/%s/%zu setup failed\n", bench->group, bench->name, bench->param);
+            status = EXIT_FAILURE;
+            continue;
+        }
+        fprintf(stderr, "%-10s %-22s %6zu %12.2f ns/op (p99 %.2f)\n",
+                bench->group, bench->name, bench->param, result.p50, result.p99);
+        fprintf(out,
+                "%s\n    {\"group\": \"%s\", \"name\": \"%s\", \"param\": %zu, \"iterations\": %zu, "
+                "\"ns_per_op\": {\"min\": %.3f, \"mean\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f}}",
+                first ? "" : ",", bench->group, bench->name, bench->param, result.iterations,
+                result.min, result.mean, result.p50, result.p90, result.p99, result.max);
+        first = false;
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    free(samples);
+    if (out != stdout) {
+        fclose(out);
+    }
+    return status;
+}
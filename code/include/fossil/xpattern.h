@@ -18,9 +18,23 @@ extern "C"
 {
 #endif
 
+#include <xpattern/inline.h>
+#include <xpattern/alloc.h>
 #include <xpattern/contract.h>
+#include <xpattern/contract_report.h>
+#include <xpattern/contract_sample.h>
+#include <xpattern/contract_span.h>
+#include <xpattern/contract_set.h>
 #include <xpattern/observer.h>
+#include <xpattern/observer_typed.h>
 #include <xpattern/lazy.h>
+#include <xpattern/lazy_memo.h>
+#include <xpattern/lazy_future.h>
+#include <xpattern/lazy_expire.h>
+#include <xpattern/lazy_reduce.h>
+#include <xpattern/lazy_format.h>
+#include <xpattern/lazy_stream.h>
+#include <xpattern/trace.h>
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,168 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_ALLOC_H
+#define FSCL_ALLOC_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Allocator used for every block the library owns. Each call receives the
+// allocator's context plus the size of the block, so arenas and pools can
+// free and grow without keeping headers. realloc and free may be NULL:
+// realloc then falls back to alloc + copy + free, and a missing free
+// leaves release to the owner of the memory (e.g. an arena reset).
+//
+// Lazy objects, memos, expiring values, prefetchers, futures, subjects and
+// contracts capture the default allocator when they are created. A few
+// modules keep using malloc and free:
+// - lazy_future's worker pool, contract_report's ring buffers and site
+//   table, and contract_sample's per-thread counters. They are process-wide,
+//   belong to no object, and are released at thread exit or never.
+// - lazy_reduce's jobs and partial results. They are freed on worker
+//   threads, and the arena and pool allocators are not thread-safe.
+typedef struct {
+    void* (*alloc)(void* context, size_t size);
+    void* (*realloc)(void* context, void* ptr, size_t old_size, size_t new_size);
+    void (*free)(void* context, void* ptr, size_t size);
+    void* context;
+} callocator;
+
+// Bump allocator over a caller-provided buffer. Only the most recent block
+// can be freed or grown in place; everything is released by a reset.
+typedef struct {
+    callocator allocator;  // Vtable to hand to the library
+    unsigned char* base;
+    size_t capacity;
+    size_t used;
+    size_t last;           // Offset of the most recent block
+} calloc_arena;
+
+// Fixed-size block pool over a caller-provided buffer
+typedef struct {
+    callocator allocator;  // Vtable to hand to the library
+    unsigned char* base;
+    size_t block_size;
+    size_t block_count;
+    void* free_list;
+} calloc_pool;
+
+// =================================================================
+// Default Allocator
+// =================================================================
+
+/**
+ * Set the allocator captured by objects created from now on. Objects keep
+ * the allocator they were created with, so it must outlive them.
+ *
+ * @param allocator The allocator, or NULL to restore malloc/realloc/free.
+ */
+void fscl_alloc_set_default(const callocator* allocator);
+
+/**
+ * Current default allocator.
+ *
+ * @return The allocator set with fscl_alloc_set_default, or the heap allocator.
+ */
+const callocator* fscl_alloc_default(void);
+
+/**
+ * Allocator backed by malloc, realloc and free.
+ *
+ * @return The heap allocator.
+ */
+const callocator* fscl_alloc_heap(void);
+
+// =================================================================
+// Allocation
+// =================================================================
+
+/**
+ * Allocate a block.
+ *
+ * @param allocator The allocator, or NULL for the heap.
+ * @param size      Size of the block in bytes.
+ * @return          The block, or NULL on failure.
+ */
+void* fscl_alloc(const callocator* allocator, size_t size);
+
+/**
+ * Resize a block, moving it if needed.
+ *
+ * @param allocator The allocator the block came from, or NULL for the heap.
+ * @param ptr       The block, or NULL to allocate.
+ * @param old_size  Current size of the block.
+ * @param new_size  Requested size of the block.
+ * @return          The resized block, or NULL on failure (the old block is kept).
+ */
+void* fscl_realloc(const callocator* allocator, void* ptr, size_t old_size, size_t new_size);
+
+/**
+ * Free a block.
+ *
+ * @param allocator The allocator the block came from, or NULL for the heap.
+ * @param ptr       The block, may be NULL.
+ * @param size      Size of the block.
+ */
+void fscl_free(const callocator* allocator, void* ptr, size_t size);
+
+// =================================================================
+// Arena and Pool
+// =================================================================
+
+/**
+ * Initialize a bump arena. The arena is not thread-safe; use one per
+ * thread or per request.
+ *
+ * @param arena    The arena to initialize.
+ * @param buffer   Memory the arena hands out.
+ * @param capacity Size of the buffer in bytes.
+ */
+void fscl_alloc_arena_init(calloc_arena* arena, void* buffer, size_t capacity);
+
+/**
+ * Release every block of the arena at once.
+ *
+ * @param arena The arena to reset.
+ */
+void fscl_alloc_arena_reset(calloc_arena* arena);
+
+/**
+ * Initialize a fixed-size block pool. Requests larger than the block size
+ * fail. The pool is not thread-safe.
+ *
+ * @param pool       The pool to initialize.
+ * @param buffer     Memory the pool hands out.
+ * @param capacity   Size of the buffer in bytes.
+ * @param block_size Size of every block in bytes.
+ * @return           True if at least one block fits in the buffer.
+ */
+bool fscl_alloc_pool_init(calloc_pool* pool, void* buffer, size_t capacity, size_t block_size);
+
+/**
+ * Number of blocks currently free in the pool.
+ *
+ * @param pool The pool.
+ * @return     The free block count.
+ */
+size_t fscl_alloc_pool_available(const calloc_pool* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
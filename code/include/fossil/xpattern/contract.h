@@ -18,15 +18,159 @@ extern "C"
 {
 #endif
 
+#include "fossil/xpattern/alloc.h"
+#include "fossil/xpattern/inline.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 
 // Define the contract type
 typedef struct {
     bool (*pre_condition)();
     void (*post_condition)();
+    bool disabled;        // Disabled contracts always pass their checks; accessed atomically
+    size_t id;            // Registry id, 0 if not registered
+    const char* name;     // Registry name
+    const callocator* allocator;  // Owner of a created contract, NULL if not heap-owned
 } ccontract;
 
+// Static initializer, e.g. `static ccontract c = FSCL_CONTRACT_INIT(pre, NULL);`.
+// Any zero-initialized contract, such as `ccontract c = { pre, post };`, is
+// enabled as well.
+#define FSCL_CONTRACT_INIT(pre, post) { (pre), (post), false, 0, NULL, NULL }
+
+// Fixed pool of contracts carved out of caller-provided storage
+typedef struct {
+    ccontract* slots;
+    size_t capacity;
+    size_t used;
+} ccontract_arena;
+
+// Number of contracts the global registry can hold
+#ifndef FSCL_CONTRACT_REGISTRY_CAPACITY
+#define FSCL_CONTRACT_REGISTRY_CAPACITY 256
+#endif
+
+// =================================================================
+// Contract levels
+// =================================================================
+
+// Which checks the FSCL_* contract macros compile in. Set from the
+// `contract_level` meson option; checks above the level cost nothing and
+// never evaluate their arguments. The fscl_contract_* functions below are
+// unaffected and always run.
+#define FSCL_CONTRACT_LEVEL_OFF   0 // No checks
+#define FSCL_CONTRACT_LEVEL_PRE   1 // Preconditions only
+#define FSCL_CONTRACT_LEVEL_FULL  2 // Pre/postconditions and assertions
+#define FSCL_CONTRACT_LEVEL_AUDIT 3 // Everything, including expensive audits
+
+#ifndef FSCL_CONTRACT_LEVEL
+#define FSCL_CONTRACT_LEVEL FSCL_CONTRACT_LEVEL_FULL
+#endif
+
+// Set from the `contract_profile` meson option. With GCC or Clang every
+// FSCL_* check then gets an implicit static site and shows up in
+// fscl_contract_profile_report (see contract_sample.h). Profiled checks
+// cannot be used in non-static inline functions.
+#ifndef FSCL_CONTRACT_PROFILE
+#define FSCL_CONTRACT_PROFILE 0
+#endif
+
+// Profiled builds keep the requirement fast paths out of line
+#if FSCL_CONTRACT_PROFILE
+#define FSCL_CONTRACT_INLINE_API
+#else
+#define FSCL_CONTRACT_INLINE_API FSCL_INLINE_API
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FSCL_LIKELY(cond) __builtin_expect(!!(cond), 1)
+#define FSCL_UNLIKELY(cond) __builtin_expect(!!(cond), 0)
+#define FSCL_CONTRACT_COLD __attribute__((cold, noinline))
+#else
+#define FSCL_LIKELY(cond) (!!(cond))
+#define FSCL_UNLIKELY(cond) (!!(cond))
+#define FSCL_CONTRACT_COLD
+#endif
+
+/**
+ * Report a failed contract macro. Kept out of line and marked cold so the
+ * checking call site stays a single predicted branch.
+ *
+ * @param kind    The kind of check, e.g. "require".
+ * @param message The failed condition or parameter name.
+ * @param file    Source file of the check.
+ * @param line    Source line of the check.
+ * @return        Always false.
+ */
+FSCL_CONTRACT_COLD bool fscl_contract_fail(const char* kind, const char* message, const char* file, int line);
+
+// Disabled checks still type-check `cond` but never evaluate it
+static inline bool fscl_contract_elided(size_t unused) {
+    (void)unused;
+    return true;
+}
+
+// Lets a check be used as a statement without unused-value warnings
+static inline bool fscl_contract_checked(bool result) {
+    return result;
+}
+
+#define FSCL_CONTRACT_CHECK_PLAIN_(kind, cond, message) \
+    fscl_contract_checked(FSCL_LIKELY(cond) ? true : fscl_contract_fail(kind, message, __FILE__, __LINE__))
+#if FSCL_CONTRACT_PROFILE && (defined(__GNUC__) || defined(__clang__))
+#define FSCL_CONTRACT_CHECK_(kind, cond, message, site_name) \
+    FSCL_CONTRACT_IMPLICIT_SITE_(site_name, FSCL_CONTRACT_CHECK_PLAIN_(kind, cond, message))
+#else
+#define FSCL_CONTRACT_CHECK_(kind, cond, message, site_name) FSCL_CONTRACT_CHECK_PLAIN_(kind, cond, message)
+#endif
+#define FSCL_CONTRACT_ELIDE_(cond) fscl_contract_elided(sizeof(!(cond)))
+
+#if FSCL_CONTRACT_LEVEL >= FSCL_CONTRACT_LEVEL_PRE
+#define FSCL_REQUIRE(cond) FSCL_CONTRACT_CHECK_("require", cond, #cond, #cond)
+#define FSCL_REQUIRE_MSG(cond, message) FSCL_CONTRACT_CHECK_("require", cond, message, #cond)
+#else
+#define FSCL_REQUIRE(cond) FSCL_CONTRACT_ELIDE_(cond)
+#define FSCL_REQUIRE_MSG(cond, message) FSCL_CONTRACT_ELIDE_(cond)
+#endif
+
+#if FSCL_CONTRACT_LEVEL >= FSCL_CONTRACT_LEVEL_FULL
+#define FSCL_ENSURE(cond) FSCL_CONTRACT_CHECK_("ensure", cond, #cond, #cond)
+#define FSCL_ASSERT(cond) FSCL_CONTRACT_CHECK_("assert", cond, #cond, #cond)
+#else
+#define FSCL_ENSURE(cond) FSCL_CONTRACT_ELIDE_(cond)
+#define FSCL_ASSERT(cond) FSCL_CONTRACT_ELIDE_(cond)
+#endif
+
+#if FSCL_CONTRACT_LEVEL >= FSCL_CONTRACT_LEVEL_AUDIT
+#define FSCL_AUDIT(cond) FSCL_CONTRACT_CHECK_("audit", cond, #cond, #cond)
+#else
+#define FSCL_AUDIT(cond) FSCL_CONTRACT_ELIDE_(cond)
+#endif
+
+// Precondition front-ends for the fscl_contract_require_* checks
+#define FSCL_REQUIRE_NOT_NULL(ptr, param_name) FSCL_REQUIRE_MSG((ptr) != NULL, param_name)
+#define FSCL_REQUIRE_POSITIVE(value, param_name) FSCL_REQUIRE_MSG((value) > 0, param_name)
+#define FSCL_REQUIRE_NON_NEGATIVE(value, param_name) FSCL_REQUIRE_MSG((value) >= 0, param_name)
+#define FSCL_REQUIRE_WITHIN_RANGE(value, min, max, param_name) \
+    FSCL_REQUIRE_MSG((value) >= (min) && (value) <= (max), param_name)
+#define FSCL_REQUIRE_POINTER_EQUALITY(ptr1, ptr2, param_name) \
+    FSCL_REQUIRE_MSG((const void*)(ptr1) == (const void*)(ptr2), param_name)
+#define FSCL_REQUIRE_STRING_LENGTH(str, min_length, max_length, param_name) \
+    FSCL_REQUIRE_MSG(fscl_contract_string_length_within(str, min_length, max_length), param_name)
+#define FSCL_REQUIRE_STRING_EQUALITY(str1, str2, param_name) \
+    FSCL_REQUIRE_MSG(strcmp(str1, str2) == 0, param_name)
+
+/**
+ * Check that a string's length is within a range without reporting.
+ *
+ * @param str        The string to check, NULL counts as empty.
+ * @param min_length The minimum allowed length.
+ * @param max_length The maximum allowed length.
+ * @return           True if the length is within the range.
+ */
+bool fscl_contract_string_length_within(const char* str, size_t min_length, size_t max_length);
+
 // =================================================================
 // create and erase
 // =================================================================
@@ -39,6 +183,106 @@ typedef struct {
  */
 ccontract* fscl_contract_create(bool (*pre_condition)(), void (*post_condition)());
 
+/**
+ * Create a contract from the given allocator.
+ *
+ * @param pre_condition  The precondition function.
+ * @param post_condition The postcondition function.
+ * @param allocator      The allocator, or NULL for the heap.
+ * @return               The created contract, or NULL on failure.
+ */
+ccontract* fscl_contract_create_with(bool (*pre_condition)(), void (*post_condition)(), const callocator* allocator);
+
+/**
+ * Destroy a contract made with fscl_contract_create(_with), removing it from the
+ * registry first if needed. Contracts the library does not own, such as
+ * initialized or arena contracts, are left untouched.
+ *
+ * @param contract The contract to destroy.
+ */
+void fscl_contract_destroy(ccontract* contract);
+
+/**
+ * Initialize a contract in caller-provided storage, e.g. on the stack.
+ *
+ * @param contract       The contract to initialize.
+ * @param pre_condition  The precondition function.
+ * @param post_condition The postcondition function.
+ */
+void fscl_contract_init(ccontract* contract, bool (*pre_condition)(), void (*post_condition)());
+
+/**
+ * Initialize an arena over an array of contracts.
+ *
+ * @param arena    The arena to initialize.
+ * @param storage  Array that holds the contracts.
+ * @param capacity Number of contracts the storage holds.
+ */
+void fscl_contract_arena_init(ccontract_arena* arena, ccontract* storage, size_t capacity);
+
+/**
+ * Create a contract inside an arena.
+ *
+ * @param arena          The arena.
+ * @param pre_condition  The precondition function.
+ * @param post_condition The postcondition function.
+ * @return               The contract, or NULL if the arena is full.
+ */
+ccontract* fscl_contract_arena_create(ccontract_arena* arena, bool (*pre_condition)(), void (*post_condition)());
+
+/**
+ * Release every contract of the arena at once. Registered contracts must
+ * be removed from the registry first.
+ *
+ * @param arena The arena to reset.
+ */
+void fscl_contract_arena_reset(ccontract_arena* arena);
+
+// =================================================================
+// Registry
+// =================================================================
+
+/**
+ * Add a contract to the global registry under a name.
+ *
+ * @param contract The contract, which must outlive its registration.
+ * @param name     The name, which must outlive the registration.
+ * @return         The id of the contract, or 0 if the registry is full.
+ */
+size_t fscl_contract_registry_add(ccontract* contract, const char* name);
+
+/**
+ * Remove a contract from the global registry.
+ *
+ * @param contract The contract to remove.
+ */
+void fscl_contract_registry_remove(ccontract* contract);
+
+/**
+ * Look up a registered contract by id in constant time.
+ *
+ * @param id The id returned by fscl_contract_registry_add.
+ * @return   The contract, or NULL if the id is not registered.
+ */
+ccontract* fscl_contract_registry_lookup(size_t id);
+
+/**
+ * Look up a registered contract by name.
+ *
+ * @param name The name given to fscl_contract_registry_add.
+ * @return     The contract, or NULL if no contract has the name.
+ */
+ccontract* fscl_contract_registry_find(const char* name);
+
+/**
+ * Enable or disable a registered contract at runtime.
+ *
+ * @param id      The id of the contract.
+ * @param enabled False to make its checks pass without running.
+ * @return        True if the id is registered.
+ */
+bool fscl_contract_registry_enable(size_t id, bool enabled);
+
 // =================================================================
 // Additional functions
 // =================================================================
@@ -75,7 +319,7 @@ bool fscl_contract_assert(bool condition, const char* message);
  * @param param_name The name of the parameter.
  * @return           True if the requirement is met, false otherwise.
  */
-bool fscl_contract_require_not_null(const void* ptr, const char* param_name);
+FSCL_CONTRACT_INLINE_API bool fscl_contract_require_not_null(const void* ptr, const char* param_name);
 
 // Other require functions ...
 
@@ -95,7 +339,7 @@ bool fscl_contract_require_custom_condition(bool (*custom_condition)(), const ch
  * @param param_name The name of the parameter for error reporting.
  * @return true if the requirement is met, false otherwise.
  */
-bool fscl_contract_require_not_null(const void *ptr, const char *param_name);
+FSCL_CONTRACT_INLINE_API bool fscl_contract_require_not_null(const void *ptr, const char *param_name);
 
 /**
  * Require that an integer value is positive.
@@ -104,7 +348,7 @@ bool fscl_contract_require_not_null(const void *ptr, const char *param_name);
  * @param param_name The name of the parameter for error reporting.
  * @return true if the requirement is met, false otherwise.
  */
-bool fscl_contract_require_positive(int value, const char *param_name);
+FSCL_CONTRACT_INLINE_API bool fscl_contract_require_positive(int value, const char *param_name);
 
 /**
  * Require that an integer value is non-negative.
@@ -113,7 +357,7 @@ bool fscl_contract_require_positive(int value, const char *param_name);
  * @param param_name The name of the parameter for error reporting.
  * @return true if the requirement is met, false otherwise.
  */
-bool fscl_contract_require_non_negative(int value, const char *param_name);
+FSCL_CONTRACT_INLINE_API bool fscl_contract_require_non_negative(int value, const char *param_name);
 
 /**
  * Require that an integer value is within a specified range.
@@ -124,7 +368,7 @@ bool fscl_contract_require_non_negative(int value, const char *param_name);
  * @param param_name The name of the parameter for error reporting.
  * @return true if the requirement is met, false otherwise.
  */
-bool fscl_contract_require_within_range(int value, int min, int max, const char *param_name);
+FSCL_CONTRACT_INLINE_API bool fscl_contract_require_within_range(int value, int min, int max, const char *param_name);
 
 /**
  * Require that a double value is within a specified range.
@@ -135,7 +379,7 @@ bool fscl_contract_require_within_range(int value, int min, int max, const char
  * @param param_name The name of the parameter for error reporting.
  * @return true if the requirement is met, false otherwise.
  */
-bool fscl_contract_require_within_double_range(double value, double min, double max, const char *param_name);
+FSCL_CONTRACT_INLINE_API bool fscl_contract_require_within_double_range(double value, double min, double max, const char *param_name);
 
 /**
  * Require that the length of a string is within a specified range.
@@ -156,7 +400,7 @@ bool fscl_contract_require_string_length(const char *str, size_t min_length, siz
  * @param param_name The name of the parameter for error reporting.
  * @return true if the requirement is met, false otherwise.
  */
-bool fscl_contract_require_pointer_equality(const void *ptr1, const void *ptr2, const char *param_name);
+FSCL_CONTRACT_INLINE_API bool fscl_contract_require_pointer_equality(const void *ptr1, const void *ptr2, const char *param_name);
 
 /**
  * Require that two strings are equal.
@@ -171,6 +415,10 @@ bool fscl_contract_require_string_equality(const char *str1, const char *str2, c
 /**
  * Require that the length of an array is equal to the expected length.
  *
+ * Deprecated: the length is measured with strlen, which is only right for
+ * NUL-terminated byte arrays. Use fscl_contract_require_span_length from
+ * contract_span.h instead.
+ *
  * @param array The array to check.
  * @param expected_length The expected length of the array.
  * @param element_size The size of each element in the array.
@@ -179,8 +427,43 @@ bool fscl_contract_require_string_equality(const char *str1, const char *str2, c
  */
 bool fscl_contract_require_array_length(const void *array, size_t expected_length, size_t element_size, const char *param_name);
 
+// =================================================================
+// Inline Fast Paths (see inline.h)
+// =================================================================
+
+// Passing checks stay inline; only a violation calls into the library
+#if defined(FSCL_XPATTERN_INLINE) && !FSCL_CONTRACT_PROFILE
+inline bool fscl_contract_require_not_null(const void* ptr, const char* param_name) {
+    return FSCL_LIKELY(ptr != NULL) || fscl_contract_assert(false, param_name);
+}
+
+inline bool fscl_contract_require_positive(int value, const char* param_name) {
+    return FSCL_LIKELY(value > 0) || fscl_contract_assert(false, param_name);
+}
+
+inline bool fscl_contract_require_non_negative(int value, const char* param_name) {
+    return FSCL_LIKELY(value >= 0) || fscl_contract_assert(false, param_name);
+}
+
+inline bool fscl_contract_require_within_range(int value, int min, int max, const char* param_name) {
+    return FSCL_LIKELY(value >= min && value <= max) || fscl_contract_assert(false, param_name);
+}
+
+inline bool fscl_contract_require_within_double_range(double value, double min, double max, const char* param_name) {
+    return FSCL_LIKELY(value >= min && value <= max) || fscl_contract_assert(false, param_name);
+}
+
+inline bool fscl_contract_require_pointer_equality(const void* ptr1, const void* ptr2, const char* param_name) {
+    return FSCL_LIKELY(ptr1 == ptr2) || fscl_contract_assert(false, param_name);
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
 
+#if FSCL_CONTRACT_PROFILE
+#include "fossil/xpattern/contract_sample.h"
+#endif
+
 #endif
@@ -0,0 +1,138 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_CONTRACT_REPORT_H
+#define FSCL_CONTRACT_REPORT_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// While the reporter runs, a failing contract only copies the violation
+// into a ring owned by the failing thread. A background thread drains the
+// rings, folds repeats of each call site together, rate-limits every site
+// with a token bucket and hands what is left to the sink. When the reporter
+// is not running, violations are printed to stderr as before.
+
+// One reported violation, as seen by a callback sink
+typedef struct {
+    const char* kind;                // "assert", "require", ...
+    const char* message;             // Failed condition or parameter name
+    const char* file;                // Source file, NULL if unknown
+    int line;                        // Source line, 0 if unknown
+    unsigned long long occurrences;  // Times this site has failed so far
+    unsigned long long suppressed;   // Failures folded in since the last report
+} ccontract_violation;
+
+typedef void (*ccontract_report_fn)(const ccontract_violation* violation, void* context);
+
+// Reporter settings; zero fields take the defaults
+typedef struct {
+    size_t ring_size;            // Entries per new thread ring (default 256)
+    unsigned rate_per_second;    // Reports per site per second (default 10)
+    unsigned burst;              // Reports per site in a burst (default 10)
+    unsigned flush_interval_ms;  // How often the rings are drained (default 100)
+} ccontract_report_config;
+
+// Reporter counters
+typedef struct {
+    unsigned long long violations;  // Violations drained from the rings
+    unsigned long long reported;    // Violations handed to the sink
+    unsigned long long suppressed;  // Violations folded away by rate limiting
+    unsigned long long dropped;     // Violations lost because a ring was full
+    size_t sites;                   // Distinct call sites seen
+} ccontract_report_stats;
+
+// =================================================================
+// Reporter
+// =================================================================
+
+/**
+ * Start the background reporter. Reports go to stderr until another sink
+ * is chosen.
+ *
+ * @param config Reporter settings, or NULL for the defaults.
+ * @return       True if the reporter is running.
+ */
+bool fscl_contract_report_start(const ccontract_report_config* config);
+
+/**
+ * Drain every ring one last time and stop the reporter. Violations raised
+ * afterwards are printed to stderr directly.
+ */
+void fscl_contract_report_stop(void);
+
+/**
+ * Drain every ring now instead of waiting for the next interval.
+ */
+void fscl_contract_report_flush(void);
+
+/**
+ * Queue a violation for the reporter. The message is copied (and
+ * truncated if long); kind and file must be string literals.
+ *
+ * @param kind    The kind of check.
+ * @param message The failed condition or parameter name.
+ * @param file    Source file of the check, or NULL.
+ * @param line    Source line of the check, or 0.
+ * @return        True if the reporter took the violation, false if it is
+ *                not running and the caller should report it itself.
+ */
+bool fscl_contract_report_submit(const char* kind, const char* message, const char* file, int line);
+
+/**
+ * Read the reporter counters.
+ *
+ * @return A snapshot of the counters.
+ */
+ccontract_report_stats fscl_contract_report_stats(void);
+
+// =================================================================
+// Sinks
+// =================================================================
+
+/**
+ * Send reports to a callback, called on the reporter thread or on a thread
+ * that flushes or stops the reporter. The callback runs without the
+ * reporter lock held, so it may read the statistics, flush or change the
+ * sink; it must not call fscl_contract_report_stop.
+ *
+ * @param report  The callback.
+ * @param context User context passed to the callback.
+ */
+void fscl_contract_report_sink_callback(ccontract_report_fn report, void* context);
+
+/**
+ * Write reports as text lines to a file descriptor.
+ *
+ * @param fd The file descriptor, e.g. 2 for stderr.
+ */
+void fscl_contract_report_sink_fd(int fd);
+
+/**
+ * Append reports as text lines to a caller-provided buffer. The buffer is
+ * kept NUL-terminated and reports that no longer fit are discarded.
+ *
+ * @param buffer The buffer.
+ * @param size   Size of the buffer.
+ */
+void fscl_contract_report_sink_memory(char* buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
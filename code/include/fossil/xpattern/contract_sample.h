@@ -0,0 +1,261 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_CONTRACT_SAMPLE_H
+#define FSCL_CONTRACT_SAMPLE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "fossil/xpattern/contract.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// A contract site evaluates its check on 1 in `period` calls. Each thread
+// keeps its own countdown and counters, so sampling a hot site never
+// writes to memory shared with other threads. Define sites with static
+// storage through FSCL_CONTRACT_SITE.
+typedef struct {
+    const char* name;    // Name used in statistics
+    unsigned period;     // Evaluate 1 in `period` calls, 0 = never; accessed atomically
+    size_t id;           // Assigned on first use, 0 = unassigned; accessed atomically
+    const char* file;    // Where the site is defined
+    int line;
+} ccontract_site;
+
+// Run and skip counts of sampled checks
+typedef struct {
+    unsigned long long run;
+    unsigned long long skipped;
+} ccontract_sample_stats;
+
+// Per-site profile, summed over all threads
+typedef struct {
+    const char* name;
+    const char* file;
+    int line;
+    unsigned long long evaluations;  // Profiled evaluations
+    unsigned long long failures;     // Profiled evaluations that failed
+    unsigned long long cycles;       // TSC ticks on x86, nanoseconds elsewhere
+    unsigned long long run;          // Sampling decisions that ran the check
+    unsigned long long skipped;      // Sampling decisions that skipped it
+} ccontract_profile_entry;
+
+// This thread's counters for one site, looked up once per check
+typedef struct ccontract_slot ccontract_slot;
+
+#define FSCL_CONTRACT_SITE(var, site_name, site_period) \
+    static ccontract_site var = { site_name, site_period, 0, __FILE__, __LINE__ }
+
+// With GCC or Clang a check resolves its slot once and passes it to the
+// sampling and timing calls; elsewhere each call finds the slot itself
+#if FSCL_CONTRACT_PROFILE && (defined(__GNUC__) || defined(__clang__))
+#define FSCL_CONTRACT_PROFILED_(site, check) __extension__({ \
+    ccontract_slot* fscl_slot_ = fscl_contract_slot(site); \
+    fscl_contract_slot_begin(fscl_slot_); \
+    fscl_contract_slot_end(fscl_slot_, check); })
+#define FSCL_CONTRACT_SAMPLED_(site, check) __extension__({ \
+    ccontract_slot* fscl_slot_ = fscl_contract_slot(site); \
+    fscl_contract_checked(fscl_contract_slot_sample(fscl_slot_, site) ? \
+        (fscl_contract_slot_begin(fscl_slot_), fscl_contract_slot_end(fscl_slot_, check)) : true); })
+#define FSCL_CONTRACT_IMPLICIT_SITE_(site_name, check) __extension__({ \
+    static ccontract_site fscl_site_ = { site_name, 1, 0, __FILE__, __LINE__ }; \
+    FSCL_CONTRACT_PROFILED_(&fscl_site_, check); })
+#elif FSCL_CONTRACT_PROFILE
+#define FSCL_CONTRACT_PROFILED_(site, check) (fscl_contract_profile_begin(site), fscl_contract_profile_end(site, check))
+#define FSCL_CONTRACT_SAMPLED_(site, check) \
+    fscl_contract_checked(fscl_contract_sample(site) ? FSCL_CONTRACT_PROFILED_(site, check) : true)
+#define FSCL_CONTRACT_IMPLICIT_SITE_(site_name, check) (check)
+#else
+#define FSCL_CONTRACT_PROFILED_(site, check) (check)
+#define FSCL_CONTRACT_SAMPLED_(site, check) fscl_contract_checked(fscl_contract_sample(site) ? (check) : true)
+#define FSCL_CONTRACT_IMPLICIT_SITE_(site_name, check) (check)
+#endif
+
+// Precondition at a named site, checked on every call (and profiled)
+#if FSCL_CONTRACT_LEVEL >= FSCL_CONTRACT_LEVEL_PRE
+#define FSCL_REQUIRE_SITE(site, cond) FSCL_CONTRACT_PROFILED_(site, FSCL_CONTRACT_CHECK_PLAIN_("require", cond, #cond))
+#else
+#define FSCL_REQUIRE_SITE(site, cond) ((void)(site), FSCL_CONTRACT_ELIDE_(cond))
+#endif
+
+// Sampled precondition; elided below the pre level, where the site is
+// still referenced so a site declared in a function is not left unused
+#if FSCL_CONTRACT_LEVEL >= FSCL_CONTRACT_LEVEL_PRE
+#define FSCL_REQUIRE_SAMPLED(site, cond) FSCL_CONTRACT_SAMPLED_(site, FSCL_CONTRACT_CHECK_PLAIN_("require", cond, #cond))
+#else
+#define FSCL_REQUIRE_SAMPLED(site, cond) ((void)(site), FSCL_CONTRACT_ELIDE_(cond))
+#endif
+
+// Sampled audit; elided entirely below the audit level
+#if FSCL_CONTRACT_LEVEL >= FSCL_CONTRACT_LEVEL_AUDIT
+#define FSCL_AUDIT_SAMPLED(site, cond) FSCL_CONTRACT_SAMPLED_(site, FSCL_CONTRACT_CHECK_PLAIN_("audit", cond, #cond))
+#else
+#define FSCL_AUDIT_SAMPLED(site, cond) ((void)(site), FSCL_CONTRACT_ELIDE_(cond))
+#endif
+
+// =================================================================
+// Sampling
+// =================================================================
+
+/**
+ * Decide whether this call of the site evaluates its check.
+ *
+ * @param site The contract site.
+ * @return     True if the check should run on this call.
+ */
+bool fscl_contract_sample(ccontract_site* site);
+
+/**
+ * Change the sampling period of one site at runtime.
+ *
+ * @param site   The contract site.
+ * @param period Evaluate 1 in `period` calls, 1 for every call, 0 for never.
+ */
+void fscl_contract_sample_set_rate(ccontract_site* site, unsigned period);
+
+/**
+ * Override the sampling period of every site at runtime.
+ *
+ * @param period Evaluate 1 in `period` calls everywhere, or 0 to go back to
+ *               the per-site periods.
+ */
+void fscl_contract_sample_set_global_rate(unsigned period);
+
+/**
+ * Read how often the site's check ran and was skipped, over all threads.
+ *
+ * @param site The contract site.
+ * @return     A snapshot of the counters.
+ */
+ccontract_sample_stats fscl_contract_sample_stats(ccontract_site* site);
+
+/**
+ * Read the run and skip counts summed over every site.
+ *
+ * @return A snapshot of the counters.
+ */
+ccontract_sample_stats fscl_contract_sample_totals(void);
+
+// =================================================================
+// Sampled requirements
+// =================================================================
+
+/**
+ * Sampled fscl_contract_require_string_length.
+ *
+ * @param site       The contract site.
+ * @param str        The string to check.
+ * @param min_length The minimum allowed length.
+ * @param max_length The maximum allowed length.
+ * @param param_name The name of the parameter for error reporting.
+ * @return true if the check was skipped or the requirement is met.
+ */
+bool fscl_contract_require_string_length_sampled(ccontract_site* site, const char* str, size_t min_length,
+                                                 size_t max_length, const char* param_name);
+
+/**
+ * Sampled fscl_contract_require_custom_condition.
+ *
+ * @param site             The contract site.
+ * @param custom_condition The custom condition function.
+ * @param param_name       The name of the parameter for error reporting.
+ * @return true if the check was skipped or the requirement is met.
+ */
+bool fscl_contract_require_custom_condition_sampled(ccontract_site* site, bool (*custom_condition)(),
+                                                    const char* param_name);
+
+// =================================================================
+// Profiling
+// =================================================================
+
+/**
+ * Start timing one evaluation of the site. Used by the site macros when
+ * profiling is enabled.
+ *
+ * @param site The contract site.
+ */
+void fscl_contract_profile_begin(ccontract_site* site);
+
+/**
+ * Finish timing one evaluation of the site and count its outcome.
+ *
+ * @param site The contract site.
+ * @param held The result of the check.
+ * @return     The result of the check, unchanged.
+ */
+bool fscl_contract_profile_end(ccontract_site* site, bool held);
+
+/**
+ * Find this thread's slot for the site, registering the site on first use.
+ * The slot functions below accept NULL, which is returned when the slot
+ * could not be allocated.
+ *
+ * @param site The contract site.
+ * @return     The slot, or NULL.
+ */
+ccontract_slot* fscl_contract_slot(ccontract_site* site);
+
+/**
+ * fscl_contract_sample on a slot already looked up.
+ *
+ * @param slot The site's slot, may be NULL.
+ * @param site The contract site.
+ * @return     True if the check should run on this call.
+ */
+bool fscl_contract_slot_sample(ccontract_slot* slot, ccontract_site* site);
+
+/**
+ * fscl_contract_profile_begin on a slot already looked up.
+ *
+ * @param slot The site's slot, may be NULL.
+ */
+void fscl_contract_slot_begin(ccontract_slot* slot);
+
+/**
+ * fscl_contract_profile_end on a slot already looked up.
+ *
+ * @param slot The site's slot, may be NULL.
+ * @param held The result of the check.
+ * @return     The result of the check, unchanged.
+ */
+bool fscl_contract_slot_end(ccontract_slot* slot, bool held);
+
+/**
+ * Copy the profile of every site, most expensive first.
+ *
+ * @param entries  Destination array, may be NULL to only count sites.
+ * @param capacity Number of entries the array holds.
+ * @return         Number of sites, which may exceed the capacity.
+ */
+size_t fscl_contract_profile_snapshot(ccontract_profile_entry* entries, size_t capacity);
+
+/**
+ * Print a table of every site, most expensive first.
+ *
+ * @param stream The stream to print to.
+ */
+void fscl_contract_profile_report(FILE* stream);
+
+/**
+ * Zero every site's counters. Counts made concurrently may be lost.
+ */
+void fscl_contract_profile_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
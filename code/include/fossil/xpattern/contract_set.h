@@ -0,0 +1,117 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_CONTRACT_SET_H
+#define FSCL_CONTRACT_SET_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "fossil/xpattern/contract.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Predicate over the caller's context, e.g. the request being validated
+typedef bool (*ccontract_predicate)(const void* context);
+
+// One predicate of a contract set with its observed behaviour
+typedef struct {
+    ccontract_predicate check;
+    const char* name;
+    unsigned long long evaluations;
+    unsigned long long failures;
+    unsigned long long timed;    // Evaluations that were timed
+    unsigned long long cost_ns;  // Time spent in the timed evaluations
+    double rank;                 // Ordering key from the last reorder
+} ccontract_rule;
+
+// Flat group of predicates checked together in one short-circuit pass.
+// Rules live in caller-provided storage, so a set never allocates. With
+// adaptive ordering off, checking a set only reads it and may be shared
+// between threads; with it on, a set belongs to one thread.
+typedef struct {
+    ccontract_rule* rules;
+    size_t count;
+    size_t capacity;
+    unsigned reorder_interval;       // Checks between reorders, 0 = fixed order
+    unsigned long long checks;       // Checks since the last reorder
+} ccontract_set;
+
+// =================================================================
+// Create and Erase
+// =================================================================
+
+/**
+ * Initialize an empty contract set over caller-provided rule storage.
+ *
+ * @param set      The contract set to initialize.
+ * @param storage  Array that holds the rules.
+ * @param capacity Number of rules the storage holds.
+ */
+void fscl_contract_set_init(ccontract_set* set, ccontract_rule* storage, size_t capacity);
+
+/**
+ * Append a predicate to the set.
+ *
+ * @param set   The contract set.
+ * @param check The predicate, called with the context given to the check.
+ * @param name  Name used when the predicate fails.
+ * @return      True if added, false if the storage is full.
+ */
+bool fscl_contract_set_add(ccontract_set* set, ccontract_predicate check, const char* name);
+
+// =================================================================
+// Additional functions
+// =================================================================
+
+/**
+ * Turn adaptive ordering on or off. When on, the set records how often and
+ * how expensively each predicate fails and every `reorder_interval` checks
+ * moves the cheapest, most likely to fail predicates to the front.
+ *
+ * @param set              The contract set.
+ * @param reorder_interval Checks between reorders, or 0 to keep the order.
+ */
+void fscl_contract_set_adaptive(ccontract_set* set, unsigned reorder_interval);
+
+/**
+ * Evaluate the predicates in order, stopping at the first failure.
+ *
+ * @param set     The contract set.
+ * @param context Passed to every predicate.
+ * @return        The failing rule, or NULL if every predicate held.
+ */
+const ccontract_rule* fscl_contract_set_check(ccontract_set* set, const void* context);
+
+/**
+ * Evaluate the set and report the failing predicate, if any.
+ *
+ * @param set     The contract set.
+ * @param context Passed to every predicate.
+ * @return        True if every predicate held, false otherwise.
+ */
+bool fscl_contract_set_require(ccontract_set* set, const void* context);
+
+/**
+ * Reorder the predicates now from the statistics gathered so far.
+ *
+ * @param set The contract set.
+ */
+void fscl_contract_set_reorder(ccontract_set* set);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
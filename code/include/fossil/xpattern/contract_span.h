@@ -0,0 +1,156 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_CONTRACT_SPAN_H
+#define FSCL_CONTRACT_SPAN_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "fossil/xpattern/contract.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Length-carrying view of an array, so checks never have to guess where
+// the data ends
+typedef struct {
+    const void* data;
+    size_t length;        // Number of elements
+    size_t element_size;  // Size of one element in bytes
+} ccontract_span;
+
+// Span over a true array (not a pointer)
+#define FSCL_CONTRACT_SPAN(array) \
+    ((ccontract_span){ (array), sizeof(array) / sizeof((array)[0]), sizeof((array)[0]) })
+
+// The bulk validators below pick SSE2 or AVX2 kernels at runtime when the
+// CPU has them and fall back to portable loops otherwise.
+
+// =================================================================
+// Span requirements
+// =================================================================
+
+/**
+ * Create a span over `length` elements of `element_size` bytes.
+ *
+ * @param data         The first element.
+ * @param length       Number of elements.
+ * @param element_size Size of one element in bytes.
+ * @return             The span.
+ */
+ccontract_span fscl_contract_span(const void* data, size_t length, size_t element_size);
+
+/**
+ * Require that a span holds exactly the expected number of elements of the
+ * expected size. Replaces fscl_contract_require_array_length.
+ *
+ * @param span            The span to check.
+ * @param expected_length The expected number of elements.
+ * @param element_size    The expected size of one element.
+ * @param param_name      The name of the parameter for error reporting.
+ * @return true if the requirement is met, false otherwise.
+ */
+bool fscl_contract_require_span_length(ccontract_span span, size_t expected_length, size_t element_size,
+                                       const char* param_name);
+
+// =================================================================
+// Bulk requirements
+// =================================================================
+
+/**
+ * Require that every integer lies within [min, max].
+ *
+ * @param values     The integers to check.
+ * @param count      Number of integers.
+ * @param min        The minimum allowed value.
+ * @param max        The maximum allowed value.
+ * @param param_name The name of the parameter for error reporting.
+ * @return true if the requirement is met, false otherwise.
+ */
+bool fscl_contract_require_all_within_range(const int* values, size_t count, int min, int max, const char* param_name);
+
+/**
+ * Require that every double lies within [min, max]. NaN never does.
+ *
+ * @param values     The doubles to check.
+ * @param count      Number of doubles.
+ * @param min        The minimum allowed value.
+ * @param max        The maximum allowed value.
+ * @param param_name The name of the parameter for error reporting.
+ * @return true if the requirement is met, false otherwise.
+ */
+bool fscl_contract_require_all_within_double_range(const double* values, size_t count, double min, double max,
+                                                   const char* param_name);
+
+/**
+ * Require that no pointer in the array is null.
+ *
+ * @param pointers   The pointers to check.
+ * @param count      Number of pointers.
+ * @param param_name The name of the parameter for error reporting.
+ * @return true if the requirement is met, false otherwise.
+ */
+bool fscl_contract_require_all_not_null(const void* const* pointers, size_t count, const char* param_name);
+
+/**
+ * Require that a string's length is within [min_length, max_length],
+ * reading at most max_length + 1 bytes. Unlike
+ * fscl_contract_require_string_length it is safe on unterminated buffers
+ * and costs the same for a huge string as for one just over the limit.
+ *
+ * @param str        The string to check, NULL counts as empty.
+ * @param min_length The minimum allowed length.
+ * @param max_length The maximum allowed length.
+ * @param param_name The name of the parameter for error reporting.
+ * @return true if the requirement is met, false otherwise.
+ */
+bool fscl_contract_require_string_length_bounded(const char* str, size_t min_length, size_t max_length,
+                                                 const char* param_name);
+
+/**
+ * Index of the first integer outside [min, max].
+ *
+ * @param values The integers to check.
+ * @param count  Number of integers.
+ * @param min    The minimum allowed value.
+ * @param max    The maximum allowed value.
+ * @return       The index, or count if every value is within range.
+ */
+size_t fscl_contract_find_outside_range(const int* values, size_t count, int min, int max);
+
+/**
+ * Index of the first double outside [min, max] or NaN.
+ *
+ * @param values The doubles to check.
+ * @param count  Number of doubles.
+ * @param min    The minimum allowed value.
+ * @param max    The maximum allowed value.
+ * @return       The index, or count if every value is within range.
+ */
+size_t fscl_contract_find_outside_double_range(const double* values, size_t count, double min, double max);
+
+/**
+ * Index of the first null pointer.
+ *
+ * @param pointers The pointers to check.
+ * @param count    Number of pointers.
+ * @return         The index, or count if no pointer is null.
+ */
+size_t fscl_contract_find_null(const void* const* pointers, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
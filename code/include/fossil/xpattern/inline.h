@@ -0,0 +1,28 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_INLINE_H
+#define FSCL_INLINE_H
+
+// Define FSCL_XPATTERN_INLINE before including any xpattern header (or
+// configure with -Dinline_api=true) to get the trivial fast paths of the
+// library, such as fscl_lazy_force_int or fscl_contract_require_positive,
+// as C99 inline definitions the compiler can fold into the caller. Slow
+// paths stay in the library, which always carries the external definitions,
+// so translation units built with and without the macro link together.
+#ifdef FSCL_XPATTERN_INLINE
+#define FSCL_INLINE_API inline
+#else
+#define FSCL_INLINE_API
+#endif
+
+#endif
@@ -18,23 +18,53 @@ extern "C"
 {
 #endif
 
+#include "fossil/xpattern/alloc.h"
+#include "fossil/xpattern/inline.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 // Define a simple string type
 typedef struct {
     char *data;
 } clazy_string;
 
+// Read-only (pointer, length) view; not NUL-terminated
+typedef struct {
+    const char *data;
+    size_t length;
+} clazy_view;
+
+// Owned, length-carrying byte buffer; may contain NUL bytes
+typedef struct {
+    unsigned char *data;
+    size_t length;
+} clazy_bytes;
+
 // Enum to represent different data types
 typedef enum {
     CLAZY_INT,
     CLAZY_BOOL,
     CLAZY_CHAR,
     CLAZY_STRING,
-    CLAZY_NULL
+    CLAZY_NULL,
+    CLAZY_FILE,    // Memory-mapped file contents
+    CLAZY_INT64,
+    CLAZY_UINT64,
+    CLAZY_DOUBLE,
+    CLAZY_POINTER, // Borrowed pointer, never freed by the lazy object
+    CLAZY_BYTES
 } clazy_type;
 
-typedef struct {
+typedef struct clazy clazy;
+
+// Deferred constructor run on first force; sets the value with fscl_lazy_set_*
+typedef void (*clazy_thunk)(clazy* lazy, void* context);
+
+// Pending background evaluation (see lazy_future.h)
+typedef struct clazy_future clazy_future;
+
+struct clazy {
     int is_evaluated;
     clazy_type type;
     union {
@@ -42,6 +72,12 @@ typedef struct {
         bool bool_value;
         char char_value;
         clazy_string string_value;
+        clazy_view view_value;
+        int64_t int64_value;
+        uint64_t uint64_value;
+        double double_value;
+        void* pointer_value;
+        clazy_bytes bytes_value;
     } data;
 
     // Memoization cache
@@ -50,8 +86,30 @@ typedef struct {
         bool memoized_bool;
         char memoized_char;
         clazy_string memoized_string;
+        clazy_view memoized_view;
+        int64_t memoized_int64;
+        uint64_t memoized_uint64;
+        double memoized_double;
+        void* memoized_pointer;
+        clazy_bytes memoized_bytes;
     } cache;
-} clazy;
+
+    clazy_thunk thunk;     // Optional deferred constructor
+    void* context;         // User context passed to the thunk
+    clazy_future* future;  // Non-NULL while evaluating on the worker pool
+    const callocator* allocator;  // Owns string and byte values, NULL for the heap
+};
+
+// Produces element `index` of a stream into `out` with fscl_lazy_set_*
+typedef void (*clazy_generator)(clazy* out, size_t index, void* context);
+
+// Index-addressable lazy stream of `length` elements of one type
+typedef struct {
+    clazy_type type;
+    clazy_generator generate;
+    void* context;
+    size_t length;
+} clazy_stream;
 
 // =================================================================
 // Create and Erase
@@ -65,6 +123,35 @@ typedef struct {
  */
 clazy fscl_lazy_create(clazy_type type);
 
+/**
+ * Create a lazy object whose value is produced by a thunk on first force.
+ *
+ * @param type    The type of the lazy object.
+ * @param thunk   The deferred constructor.
+ * @param context User context passed to the thunk.
+ * @return        The created lazy object.
+ */
+clazy fscl_lazy_create_thunk(clazy_type type, clazy_thunk thunk, void* context);
+
+/**
+ * Create a lazy object that memory-maps a file on first force. Pages are
+ * read in by the kernel on access and the mapping is released on erase.
+ *
+ * @param path Path of the file to map; must outlive the lazy object.
+ * @return     The created lazy object.
+ */
+clazy fscl_lazy_create_file(const char* path);
+
+/**
+ * Choose the allocator for the string and byte values of a lazy object.
+ * Lazy objects capture the default allocator when created; any value held
+ * is erased first so it is freed by the allocator it came from.
+ *
+ * @param lazy      The lazy object.
+ * @param allocator The allocator, or NULL for the heap.
+ */
+void fscl_lazy_set_allocator(clazy* lazy, const callocator* allocator);
+
 /**
  * Erase a lazy object.
  *
@@ -89,7 +176,7 @@ void fscl_lazy_force(clazy* lazy);
  * @param lazy The lazy object to force.
  * @return     The forced integer value.
  */
-int fscl_lazy_force_int(clazy* lazy);
+FSCL_INLINE_API int fscl_lazy_force_int(clazy* lazy);
 
 /**
  * Force and return the boolean value of the lazy object.
@@ -97,7 +184,7 @@ int fscl_lazy_force_int(clazy* lazy);
  * @param lazy The lazy object to force.
  * @return     The forced boolean value.
  */
-bool fscl_lazy_force_bool(clazy* lazy);
+FSCL_INLINE_API bool fscl_lazy_force_bool(clazy* lazy);
 
 /**
  * Force and return the character value of the lazy object.
@@ -105,7 +192,7 @@ bool fscl_lazy_force_bool(clazy* lazy);
  * @param lazy The lazy object to force.
  * @return     The forced character value.
  */
-char fscl_lazy_force_char(clazy* lazy);
+FSCL_INLINE_API char fscl_lazy_force_char(clazy* lazy);
 
 /**
  * Force and return the string value of the lazy object.
@@ -113,7 +200,57 @@ char fscl_lazy_force_char(clazy* lazy);
  * @param lazy The lazy object to force.
  * @return     The forced string value.
  */
-const char* fscl_lazy_force_string(clazy* lazy);
+FSCL_INLINE_API const char* fscl_lazy_force_string(clazy* lazy);
+
+/**
+ * Force and return the 64-bit integer value of the lazy object.
+ *
+ * @param lazy The lazy object to force.
+ * @return     The forced 64-bit integer value.
+ */
+FSCL_INLINE_API int64_t fscl_lazy_force_int64(clazy* lazy);
+
+/**
+ * Force and return the unsigned 64-bit integer value of the lazy object.
+ *
+ * @param lazy The lazy object to force.
+ * @return     The forced unsigned 64-bit integer value.
+ */
+FSCL_INLINE_API uint64_t fscl_lazy_force_uint64(clazy* lazy);
+
+/**
+ * Force and return the double value of the lazy object.
+ *
+ * @param lazy The lazy object to force.
+ * @return     The forced double value.
+ */
+FSCL_INLINE_API double fscl_lazy_force_double(clazy* lazy);
+
+/**
+ * Force and return the pointer value of the lazy object.
+ *
+ * @param lazy The lazy object to force.
+ * @return     The forced pointer value.
+ */
+FSCL_INLINE_API void* fscl_lazy_force_pointer(clazy* lazy);
+
+/**
+ * Force and return the byte buffer of the lazy object. The buffer stays
+ * owned by the lazy object.
+ *
+ * @param lazy The lazy object to force.
+ * @return     The forced byte buffer.
+ */
+FSCL_INLINE_API clazy_bytes fscl_lazy_force_bytes(clazy* lazy);
+
+/**
+ * Force and return a zero-copy view of a file, string or bytes lazy object.
+ * A file that cannot be mapped yields a view with a NULL data pointer.
+ *
+ * @param lazy The lazy object to force.
+ * @return     The forced view.
+ */
+clazy_view fscl_lazy_force_view(clazy* lazy);
 
 // =================================================================
 // Additional Functions
@@ -135,15 +272,98 @@ clazy fscl_lazy_sequence(void);
  */
 int fscl_lazy_sequence_force(clazy* lazy, int n);
 
+/**
+ * Create a lazy stream whose elements are produced on demand.
+ *
+ * @param type     The type of every element.
+ * @param generate The generator producing one element by index.
+ * @param context  User context passed to the generator.
+ * @param length   Number of elements in the stream.
+ * @return         The created lazy stream.
+ */
+clazy_stream fscl_lazy_stream_create(clazy_type type, clazy_generator generate, void* context, size_t length);
+
+/**
+ * Produce and force one element of a lazy stream. The caller erases it.
+ *
+ * @param stream The lazy stream.
+ * @param index  Index of the element to produce.
+ * @return       The forced element.
+ */
+clazy fscl_lazy_stream_force(const clazy_stream* stream, size_t index);
+
 /**
  * Set the integer value of the lazy object.
  *
  * @param lazy  The lazy object to set.
  * @param value The integer value to set.
  */
-void fscl_lazy_set_int(clazy* lazy, int value);
+FSCL_INLINE_API void fscl_lazy_set_int(clazy* lazy, int value);
+
+/**
+ * Set the boolean value of the lazy object.
+ *
+ * @param lazy  The lazy object to set.
+ * @param value The boolean value to set.
+ */
+FSCL_INLINE_API void fscl_lazy_set_bool(clazy* lazy, bool value);
+
+/**
+ * Set the character value of the lazy object.
+ *
+ * @param lazy  The lazy object to set.
+ * @param value The character value to set.
+ */
+FSCL_INLINE_API void fscl_lazy_set_letter(clazy* lazy, char value);
+
+/**
+ * Set the string value of the lazy object, taking a private copy.
+ *
+ * @param lazy  The lazy object to set.
+ * @param value The string value to copy.
+ */
+void fscl_lazy_set_cstring(clazy* lazy, const char* value);
+
+/**
+ * Set the 64-bit integer value of the lazy object.
+ *
+ * @param lazy  The lazy object to set.
+ * @param value The 64-bit integer value to set.
+ */
+FSCL_INLINE_API void fscl_lazy_set_int64(clazy* lazy, int64_t value);
+
+/**
+ * Set the unsigned 64-bit integer value of the lazy object.
+ *
+ * @param lazy  The lazy object to set.
+ * @param value The unsigned 64-bit integer value to set.
+ */
+FSCL_INLINE_API void fscl_lazy_set_uint64(clazy* lazy, uint64_t value);
+
+/**
+ * Set the double value of the lazy object.
+ *
+ * @param lazy  The lazy object to set.
+ * @param value The double value to set.
+ */
+FSCL_INLINE_API void fscl_lazy_set_double(clazy* lazy, double value);
+
+/**
+ * Set the pointer value of the lazy object. The pointee is not owned.
+ *
+ * @param lazy  The lazy object to set.
+ * @param value The pointer value to set.
+ */
+FSCL_INLINE_API void fscl_lazy_set_pointer(clazy* lazy, void* value);
 
-// Other lazy set functions ...
+/**
+ * Set the byte buffer of the lazy object, taking a private copy.
+ *
+ * @param lazy   The lazy object to set.
+ * @param data   The bytes to copy.
+ * @param length Number of bytes.
+ */
+void fscl_lazy_set_bytes(clazy* lazy, const void* data, size_t length);
 
 /**
  * Conditional evaluation of the lazy object based on the given condition.
@@ -161,7 +381,70 @@ void fscl_lazy_conditional_eval(clazy* lazy, int condition);
  */
 void fscl_lazy_map_int(clazy* lazy, int (*mapFunction)(int));
 
-// Other lazy map functions ...
+/**
+ * Map the lazy boolean object using the provided mapping function.
+ *
+ * @param lazy          The lazy boolean object to map.
+ * @param mapFunction   The mapping function for booleans.
+ */
+void fscl_lazy_map_bool(clazy* lazy, bool (*mapFunction)(bool));
+
+/**
+ * Map the lazy character object using the provided mapping function.
+ *
+ * @param lazy          The lazy character object to map.
+ * @param mapFunction   The mapping function for characters.
+ */
+void fscl_lazy_map_char(clazy* lazy, char (*mapFunction)(char));
+
+/**
+ * Map the lazy string object using the provided mapping function.
+ *
+ * @param lazy          The lazy string object to map.
+ * @param mapFunction   The mapping function for strings.
+ */
+void fscl_lazy_map_cstring(clazy* lazy, const char* (*mapFunction)(const char*));
+
+/**
+ * Map the lazy 64-bit integer object using the provided mapping function.
+ *
+ * @param lazy          The lazy 64-bit integer object to map.
+ * @param mapFunction   The mapping function for 64-bit integers.
+ */
+void fscl_lazy_map_int64(clazy* lazy, int64_t (*mapFunction)(int64_t));
+
+/**
+ * Map the lazy unsigned 64-bit integer object using the provided mapping function.
+ *
+ * @param lazy          The lazy unsigned 64-bit integer object to map.
+ * @param mapFunction   The mapping function for unsigned 64-bit integers.
+ */
+void fscl_lazy_map_uint64(clazy* lazy, uint64_t (*mapFunction)(uint64_t));
+
+/**
+ * Map the lazy double object using the provided mapping function.
+ *
+ * @param lazy          The lazy double object to map.
+ * @param mapFunction   The mapping function for doubles.
+ */
+void fscl_lazy_map_double(clazy* lazy, double (*mapFunction)(double));
+
+/**
+ * Map the lazy pointer object using the provided mapping function.
+ *
+ * @param lazy          The lazy pointer object to map.
+ * @param mapFunction   The mapping function for pointers.
+ */
+void fscl_lazy_map_pointer(clazy* lazy, void* (*mapFunction)(void*));
+
+/**
+ * Map the lazy bytes object using the provided mapping function. The
+ * returned view is copied, so it may point at static or input storage.
+ *
+ * @param lazy          The lazy bytes object to map.
+ * @param mapFunction   The mapping function for byte views.
+ */
+void fscl_lazy_map_bytes(clazy* lazy, clazy_view (*mapFunction)(clazy_view));
 
 /**
  * Concatenate two lazy string objects and store the result in another lazy object.
@@ -179,6 +462,120 @@ void fscl_lazy_concat_cstrings(clazy* result, clazy* str1, clazy* str2);
  */
 void fscl_lazy_print(clazy* lazy);
 
+// =================================================================
+// Inline Fast Paths (see inline.h)
+// =================================================================
+
+#ifdef FSCL_XPATTERN_INLINE
+// Evaluated values are read straight from the cache
+#define FSCL_LAZY_READY_(lazy) ((lazy)->future == NULL && (lazy)->is_evaluated)
+
+inline int fscl_lazy_force_int(clazy* lazy) {
+    if (!FSCL_LAZY_READY_(lazy)) {
+        fscl_lazy_force(lazy);
+    }
+    return lazy->cache.memoized_int;
+}
+
+inline bool fscl_lazy_force_bool(clazy* lazy) {
+    if (!FSCL_LAZY_READY_(lazy)) {
+        fscl_lazy_force(lazy);
+    }
+    return lazy->cache.memoized_bool;
+}
+
+inline char fscl_lazy_force_char(clazy* lazy) {
+    if (!FSCL_LAZY_READY_(lazy)) {
+        fscl_lazy_force(lazy);
+    }
+    return lazy->cache.memoized_char;
+}
+
+inline const char* fscl_lazy_force_string(clazy* lazy) {
+    if (!FSCL_LAZY_READY_(lazy)) {
+        fscl_lazy_force(lazy);
+    }
+    return lazy->cache.memoized_string.data;
+}
+
+inline int64_t fscl_lazy_force_int64(clazy* lazy) {
+    if (!FSCL_LAZY_READY_(lazy)) {
+        fscl_lazy_force(lazy);
+    }
+    return lazy->cache.memoized_int64;
+}
+
+inline uint64_t fscl_lazy_force_uint64(clazy* lazy) {
+    if (!FSCL_LAZY_READY_(lazy)) {
+        fscl_lazy_force(lazy);
+    }
+    return lazy->cache.memoized_uint64;
+}
+
+inline double fscl_lazy_force_double(clazy* lazy) {
+    if (!FSCL_LAZY_READY_(lazy)) {
+        fscl_lazy_force(lazy);
+    }
+    return lazy->cache.memoized_double;
+}
+
+inline void* fscl_lazy_force_pointer(clazy* lazy) {
+    if (!FSCL_LAZY_READY_(lazy)) {
+        fscl_lazy_force(lazy);
+    }
+    return lazy->cache.memoized_pointer;
+}
+
+inline clazy_bytes fscl_lazy_force_bytes(clazy* lazy) {
+    if (!FSCL_LAZY_READY_(lazy)) {
+        fscl_lazy_force(lazy);
+    }
+    return lazy->cache.memoized_bytes;
+}
+
+inline void fscl_lazy_set_int(clazy* lazy, int value) {
+    lazy->is_evaluated = 1;
+    lazy->data.int_value = value;
+    lazy->cache.memoized_int = value;
+}
+
+inline void fscl_lazy_set_bool(clazy* lazy, bool value) {
+    lazy->is_evaluated = 1;
+    lazy->data.bool_value = value;
+    lazy->cache.memoized_bool = value;
+}
+
+inline void fscl_lazy_set_letter(clazy* lazy, char value) {
+    lazy->is_evaluated = 1;
+    lazy->data.char_value = value;
+    lazy->cache.memoized_char = value;
+}
+
+inline void fscl_lazy_set_int64(clazy* lazy, int64_t value) {
+    lazy->is_evaluated = 1;
+    lazy->data.int64_value = value;
+    lazy->cache.memoized_int64 = value;
+}
+
+inline void fscl_lazy_set_uint64(clazy* lazy, uint64_t value) {
+    lazy->is_evaluated = 1;
+    lazy->data.uint64_value = value;
+    lazy->cache.memoized_uint64 = value;
+}
+
+inline void fscl_lazy_set_double(clazy* lazy, double value) {
+    lazy->is_evaluated = 1;
+    lazy->data.double_value = value;
+    lazy->cache.memoized_double = value;
+}
+
+inline void fscl_lazy_set_pointer(clazy* lazy, void* value) {
+    lazy->is_evaluated = 1;
+    lazy->data.pointer_value = value;
+    lazy->cache.memoized_pointer = value;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
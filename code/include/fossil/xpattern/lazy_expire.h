@@ -0,0 +1,133 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_LAZY_EXPIRE_H
+#define FSCL_LAZY_EXPIRE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "fossil/xpattern/lazy.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Time-bounded lazy value. Readers inside the refresh-ahead window keep
+// getting the current value while a worker recomputes it in the background
+// (stale-while-revalidate). Readers past the TTL wait for a fresh value,
+// and only one of them runs the thunk.
+typedef struct {
+    clazy value;                           // Current value
+    clazy_thunk thunk;                     // Recomputes the value
+    void* context;                         // User context for the thunk
+    unsigned long long ttl_ns;             // Lifetime of a value, 0 = forever
+    unsigned long long refresh_ahead_ns;   // Refresh window before expiry, 0 = off
+    unsigned long long loaded_at;          // Monotonic time the value was computed
+    bool loading;                          // A reader is recomputing the value
+    bool refreshing;                       // A background refresh is queued
+    unsigned long generation;              // Bumped by invalidate; older loads are dropped
+    void* sync;                            // Internal lock and condition
+    const callocator* allocator;           // Owns the internal lock and condition
+} clazy_expire;
+
+// =================================================================
+// Create and Erase
+// =================================================================
+
+/**
+ * Create an expiring lazy object.
+ *
+ * @param expire           The expiring lazy object to initialize.
+ * @param type             The type of the value.
+ * @param thunk            The function that computes the value.
+ * @param context          User context passed to the thunk.
+ * @param ttl_ms           Lifetime of a value in milliseconds, 0 for forever.
+ * @param refresh_ahead_ms Start a background refresh this long before
+ *                         expiry, 0 to disable refresh-ahead.
+ * @return                 True on success, false if allocation failed.
+ */
+bool fscl_lazy_expire_create(clazy_expire* expire, clazy_type type, clazy_thunk thunk, void* context,
+                             unsigned long ttl_ms, unsigned long refresh_ahead_ms);
+
+/**
+ * Erase an expiring lazy object, waiting for any refresh in flight.
+ *
+ * @param expire The expiring lazy object to erase.
+ */
+void fscl_lazy_expire_erase(clazy_expire* expire);
+
+// =================================================================
+// Jedi Dreamer Force Functions
+// =================================================================
+
+/**
+ * Force and return the integer value, recomputing it if expired.
+ *
+ * @param expire The expiring lazy object to force.
+ * @return       The forced integer value.
+ */
+int fscl_lazy_expire_force_int(clazy_expire* expire);
+
+/**
+ * Force and return the boolean value, recomputing it if expired.
+ *
+ * @param expire The expiring lazy object to force.
+ * @return       The forced boolean value.
+ */
+bool fscl_lazy_expire_force_bool(clazy_expire* expire);
+
+/**
+ * Force and return the character value, recomputing it if expired.
+ *
+ * @param expire The expiring lazy object to force.
+ * @return       The forced character value.
+ */
+char fscl_lazy_expire_force_char(clazy_expire* expire);
+
+/**
+ * Force the string value, recomputing it if expired, and copy it into the
+ * buffer. The value may be replaced by a refresh at any time, so it is
+ * never handed out by pointer.
+ *
+ * @param expire The expiring lazy object to force.
+ * @param buffer Destination buffer, always NUL-terminated if size > 0.
+ * @param size   Size of the destination buffer.
+ * @return       Length of the full string, as with snprintf.
+ */
+size_t fscl_lazy_expire_force_string(clazy_expire* expire, char* buffer, size_t size);
+
+// =================================================================
+// Additional Functions
+// =================================================================
+
+/**
+ * Mark the value as expired so the next force recomputes it. A refresh or
+ * load that started before the call is discarded when it completes.
+ *
+ * @param expire The expiring lazy object to invalidate.
+ */
+void fscl_lazy_expire_invalidate(clazy_expire* expire);
+
+/**
+ * Check whether the value is missing or past its TTL.
+ *
+ * @param expire The expiring lazy object to check.
+ * @return       True if the next force will recompute the value.
+ */
+bool fscl_lazy_expire_is_stale(clazy_expire* expire);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
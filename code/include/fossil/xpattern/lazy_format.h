@@ -0,0 +1,171 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_LAZY_FORMAT_H
+#define FSCL_LAZY_FORMAT_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "fossil/xpattern/lazy.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Receives a full sink buffer; returns false if the data could not be written
+typedef bool (*clazy_sink_flush)(void* context, const char* data, size_t length);
+
+// Output sink over a caller-provided buffer. A buffer sink has no flush
+// and marks itself failed when it runs out of room; fd and callback sinks
+// flush whenever the buffer fills up.
+typedef struct {
+    char* buffer;
+    size_t size;
+    size_t length;
+    clazy_sink_flush flush;
+    void* context;
+    int fd;
+    bool failed;
+} clazy_sink;
+
+// =================================================================
+// Sinks
+// =================================================================
+
+/**
+ * Initialize a sink that formats into a fixed buffer.
+ *
+ * @param sink   The sink to initialize.
+ * @param buffer The destination buffer.
+ * @param size   Size of the destination buffer.
+ */
+void fscl_lazy_sink_buffer(clazy_sink* sink, char* buffer, size_t size);
+
+/**
+ * Initialize a sink that writes to a file descriptor through a buffer.
+ *
+ * @param sink   The sink to initialize.
+ * @param fd     The file descriptor to write to.
+ * @param buffer The staging buffer.
+ * @param size   Size of the staging buffer.
+ */
+void fscl_lazy_sink_fd(clazy_sink* sink, int fd, char* buffer, size_t size);
+
+/**
+ * Initialize a sink that hands full buffers to a callback.
+ *
+ * @param sink    The sink to initialize.
+ * @param flush   The callback receiving buffered data.
+ * @param context User context passed to the callback.
+ * @param buffer  The staging buffer.
+ * @param size    Size of the staging buffer.
+ */
+void fscl_lazy_sink_callback(clazy_sink* sink, clazy_sink_flush flush, void* context, char* buffer, size_t size);
+
+/**
+ * Append raw bytes to the sink.
+ *
+ * @param sink   The sink to write to.
+ * @param data   The bytes to write.
+ * @param length Number of bytes.
+ * @return       False once the sink has failed.
+ */
+bool fscl_lazy_sink_write(clazy_sink* sink, const void* data, size_t length);
+
+/**
+ * Flush buffered data of an fd or callback sink.
+ *
+ * @param sink The sink to flush.
+ * @return     False once the sink has failed.
+ */
+bool fscl_lazy_sink_flush(clazy_sink* sink);
+
+// =================================================================
+// Formatting
+// =================================================================
+
+/**
+ * Force the lazy object and format its value into a buffer without stdio.
+ *
+ * @param lazy   The lazy object to format.
+ * @param buffer The destination buffer, NUL-terminated if size > 0.
+ * @param size   Size of the destination buffer.
+ * @return       Length of the full formatted value, as with snprintf.
+ */
+size_t fscl_lazy_format(clazy* lazy, char* buffer, size_t size);
+
+/**
+ * Force the lazy object and write its formatted value to the sink.
+ *
+ * @param sink The sink to write to.
+ * @param lazy The lazy object to format.
+ * @return     False once the sink has failed.
+ */
+bool fscl_lazy_write(clazy_sink* sink, clazy* lazy);
+
+// =================================================================
+// Binary Snapshots
+// =================================================================
+
+/**
+ * Serialize the evaluated values of a lazy array. Unevaluated objects,
+ * pointers and mapped files are recorded by type only.
+ *
+ * @param sink  The sink receiving the snapshot.
+ * @param items The lazy objects to save.
+ * @param count Number of lazy objects.
+ * @return      True if the whole snapshot was written and flushed.
+ */
+bool fscl_lazy_snapshot_save(clazy_sink* sink, clazy* items, size_t count);
+
+/**
+ * Restore values from a snapshot into already created lazy objects. A
+ * value is restored only when the recorded type matches the object's
+ * type, so thunks of the target array stay in place for values that
+ * are missing or stale.
+ *
+ * @param data     The snapshot bytes.
+ * @param length   Number of snapshot bytes.
+ * @param items    The lazy objects to warm up.
+ * @param capacity Number of lazy objects.
+ * @param restored Receives the number of values restored (may be NULL).
+ * @return         False if the snapshot is malformed.
+ */
+bool fscl_lazy_snapshot_load(const void* data, size_t length, clazy* items, size_t capacity, size_t* restored);
+
+/**
+ * Save a snapshot to a file.
+ *
+ * @param path  Path of the file to create or replace.
+ * @param items The lazy objects to save.
+ * @param count Number of lazy objects.
+ * @return      True on success.
+ */
+bool fscl_lazy_snapshot_save_file(const char* path, clazy* items, size_t count);
+
+/**
+ * Restore a snapshot from a file, reading it through a memory mapping.
+ *
+ * @param path     Path of the snapshot file.
+ * @param items    The lazy objects to warm up.
+ * @param capacity Number of lazy objects.
+ * @param restored Receives the number of values restored (may be NULL).
+ * @return         False if the file is missing or malformed.
+ */
+bool fscl_lazy_snapshot_load_file(const char* path, clazy* items, size_t capacity, size_t* restored);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,105 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_LAZY_FUTURE_H
+#define FSCL_LAZY_FUTURE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "fossil/xpattern/lazy.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// A spawned lazy object is evaluated on the shared worker pool. Until it is
+// collected with fscl_lazy_force_* (or fscl_lazy_try_force/fscl_lazy_await)
+// it must stay at the same address and be used from a single thread only.
+
+// =================================================================
+// Worker Pool
+// =================================================================
+
+/**
+ * Start the shared worker pool. The pool is started on demand with one
+ * worker per CPU, so calling this is only needed to choose the size.
+ *
+ * @param workers Number of worker threads, or 0 for one per CPU.
+ * @return        True if the pool is running.
+ */
+bool fscl_lazy_pool_start(size_t workers);
+
+/**
+ * Stop the shared worker pool after draining every queued task.
+ */
+void fscl_lazy_pool_stop(void);
+
+/**
+ * Queue a task on the shared worker pool.
+ *
+ * @param task The task function.
+ * @param arg  The argument passed to the task.
+ * @return     True if queued, false if the pool could not accept it.
+ */
+bool fscl_lazy_pool_submit(void (*task)(void* arg), void* arg);
+
+/**
+ * Number of worker threads in the shared pool.
+ *
+ * @return The worker count, or 0 if the pool is not running.
+ */
+size_t fscl_lazy_pool_workers(void);
+
+// =================================================================
+// Futures
+// =================================================================
+
+/**
+ * Start evaluating the lazy object on the worker pool. Does nothing if the
+ * object is already evaluated or spawned.
+ *
+ * @param lazy The lazy object to spawn.
+ * @return     True if the evaluation runs in the background, false if it
+ *             had to run inline on the calling thread.
+ */
+bool fscl_lazy_spawn(clazy* lazy);
+
+/**
+ * Collect the value of the lazy object without blocking. A lazy object
+ * that was never spawned is spawned first.
+ *
+ * @param lazy The lazy object to poll.
+ * @return     True if the value is ready, false if still computing.
+ */
+bool fscl_lazy_try_force(clazy* lazy);
+
+/**
+ * Block until a spawned lazy object has finished evaluating.
+ *
+ * @param lazy The lazy object to wait for.
+ */
+void fscl_lazy_await(clazy* lazy);
+
+/**
+ * Spawn every lazy object in the set and block until all are evaluated.
+ *
+ * @param lazies The lazy objects to evaluate.
+ * @param count  Number of lazy objects.
+ */
+void fscl_lazy_when_all(clazy** lazies, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,150 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_LAZY_MEMO_H
+#define FSCL_LAZY_MEMO_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "fossil/xpattern/lazy.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Slot in the memo hash table
+typedef struct {
+    union {
+        int int_key;
+        char* string_key;
+    } key;
+    union {
+        int int_value;
+        char* string_value;
+    } value;
+    size_t hash;              // Cached hash of the key
+    unsigned char used;       // Slot holds a live entry
+    unsigned char referenced; // CLOCK reference bit
+} clazy_memo_entry;
+
+// Bounded input->output cache wrapped around a pure map function
+typedef struct {
+    clazy_type type; // CLAZY_INT or CLAZY_STRING
+    union {
+        int (*map_int)(int);
+        const char* (*map_cstring)(const char*);
+    } function;
+    clazy_memo_entry* entries; // Open-addressing table (linear probing)
+    size_t mask;               // Number of slots - 1
+    size_t capacity;           // Maximum number of live entries
+    size_t count;              // Number of live entries
+    size_t hand;               // CLOCK eviction hand
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
+    void* lock;                // Non-NULL for thread-safe memos
+    const callocator* allocator; // Owns the table, lock and string entries
+} clazy_memo;
+
+// Snapshot of memo counters
+typedef struct {
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
+    size_t size;
+    size_t capacity;
+} clazy_memo_stats;
+
+// =================================================================
+// Create and Erase
+// =================================================================
+
+/**
+ * Create a memo around an integer mapping function.
+ *
+ * @param memo        The memo to initialize.
+ * @param mapFunction The pure mapping function to cache.
+ * @param capacity    Maximum number of cached results before eviction.
+ * @param thread_safe Guard the memo with a lock for concurrent callers.
+ * @return            True on success, false if allocation failed.
+ */
+bool fscl_lazy_memo_create_int(clazy_memo* memo, int (*mapFunction)(int), size_t capacity, bool thread_safe);
+
+/**
+ * Create a memo around a string mapping function. Inputs and outputs are
+ * copied into the memo, so the function may return static storage.
+ *
+ * @param memo        The memo to initialize.
+ * @param mapFunction The pure mapping function to cache.
+ * @param capacity    Maximum number of cached results before eviction.
+ * @param thread_safe Guard the memo with a lock for concurrent callers.
+ * @return            True on success, false if allocation failed.
+ */
+bool fscl_lazy_memo_create_cstring(clazy_memo* memo, const char* (*mapFunction)(const char*), size_t capacity, bool thread_safe);
+
+/**
+ * Erase a memo and every cached result.
+ *
+ * @param memo The memo to erase.
+ */
+void fscl_lazy_memo_erase(clazy_memo* memo);
+
+// =================================================================
+// Additional Functions
+// =================================================================
+
+/**
+ * Apply the memoized integer function, computing it only on a miss.
+ *
+ * @param memo  The integer memo.
+ * @param input The input value.
+ * @return      The mapped value.
+ */
+int fscl_lazy_memo_apply_int(clazy_memo* memo, int input);
+
+/**
+ * Map the lazy integer object through the memo.
+ *
+ * @param memo The integer memo.
+ * @param lazy The lazy integer object to map.
+ */
+void fscl_lazy_memo_map_int(clazy_memo* memo, clazy* lazy);
+
+/**
+ * Map the lazy string object through the memo.
+ *
+ * @param memo The string memo.
+ * @param lazy The lazy string object to map.
+ */
+void fscl_lazy_memo_map_cstring(clazy_memo* memo, clazy* lazy);
+
+/**
+ * Drop every cached result while keeping the memo usable.
+ *
+ * @param memo The memo to clear.
+ */
+void fscl_lazy_memo_clear(clazy_memo* memo);
+
+/**
+ * Read the hit, miss and eviction counters of the memo.
+ *
+ * @param memo The memo to inspect.
+ * @return     A snapshot of the counters.
+ */
+clazy_memo_stats fscl_lazy_memo_stats(clazy_memo* memo);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
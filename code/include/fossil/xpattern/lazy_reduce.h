@@ -0,0 +1,160 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_LAZY_REDUCE_H
+#define FSCL_LAZY_REDUCE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "fossil/xpattern/lazy.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Reductions force every element of a lazy array or stream. Work is split
+// into chunks that the calling thread and the shared lazy worker pool claim
+// dynamically; each participant keeps a private partial accumulator and the
+// partials are combined once at the end. Pass threads = 1 to stay on the
+// calling thread, or 0 to use every pool worker.
+//
+// The integer sum/min/max gather each chunk into a block of plain ints and
+// reduce it with SSE2 or AVX2 kernels, chosen once at runtime, with a
+// portable fallback elsewhere. Already evaluated array items are read
+// without a call into fscl_lazy_force.
+
+// User-defined fold; combine must be associative and commutative
+typedef struct {
+    size_t size;                                     // Accumulator size in bytes
+    void (*init)(void* accumulator, void* context);  // Write the identity value
+    void (*step)(void* accumulator, clazy* item, void* context);
+    void (*combine)(void* accumulator, const void* partial, void* context);
+    void* context;                                   // User context for callbacks
+} clazy_fold;
+
+// =================================================================
+// Lazy Array Reductions
+// =================================================================
+
+/**
+ * Fold a lazy array with a user-defined accumulator.
+ *
+ * @param items   The lazy objects to fold, forced in place.
+ * @param count   Number of lazy objects.
+ * @param fold    The fold description.
+ * @param result  Receives the combined accumulator (fold->size bytes).
+ * @param threads Number of participating threads, 0 for all pool workers.
+ */
+void fscl_lazy_fold(clazy* items, size_t count, const clazy_fold* fold, void* result, size_t threads);
+
+/**
+ * Sum a lazy integer array.
+ *
+ * @param items   The lazy integer objects, forced in place.
+ * @param count   Number of lazy objects.
+ * @param threads Number of participating threads, 0 for all pool workers.
+ * @return        The sum, widened to avoid overflow.
+ */
+long long fscl_lazy_sum_int(clazy* items, size_t count, size_t threads);
+
+/**
+ * Find the minimum of a lazy integer array.
+ *
+ * @param items   The lazy integer objects, forced in place.
+ * @param count   Number of lazy objects.
+ * @param threads Number of participating threads, 0 for all pool workers.
+ * @param result  Receives the minimum.
+ * @return        True if the array was not empty.
+ */
+bool fscl_lazy_min_int(clazy* items, size_t count, size_t threads, int* result);
+
+/**
+ * Find the maximum of a lazy integer array.
+ *
+ * @param items   The lazy integer objects, forced in place.
+ * @param count   Number of lazy objects.
+ * @param threads Number of participating threads, 0 for all pool workers.
+ * @param result  Receives the maximum.
+ * @return        True if the array was not empty.
+ */
+bool fscl_lazy_max_int(clazy* items, size_t count, size_t threads, int* result);
+
+/**
+ * Count the elements of a lazy array that satisfy a predicate.
+ *
+ * @param items     The lazy objects, forced in place.
+ * @param count     Number of lazy objects.
+ * @param predicate The predicate, called once per forced element.
+ * @param threads   Number of participating threads, 0 for all pool workers.
+ * @return          Number of matching elements.
+ */
+size_t fscl_lazy_count_if(clazy* items, size_t count, bool (*predicate)(clazy* item), size_t threads);
+
+// =================================================================
+// Lazy Stream Reductions
+// =================================================================
+
+/**
+ * Fold a finite lazy stream with a user-defined accumulator.
+ *
+ * @param stream  The lazy stream; every element is produced once.
+ * @param fold    The fold description.
+ * @param result  Receives the combined accumulator (fold->size bytes).
+ * @param threads Number of participating threads, 0 for all pool workers.
+ */
+void fscl_lazy_stream_fold(const clazy_stream* stream, const clazy_fold* fold, void* result, size_t threads);
+
+/**
+ * Sum a finite lazy integer stream.
+ *
+ * @param stream  The lazy integer stream.
+ * @param threads Number of participating threads, 0 for all pool workers.
+ * @return        The sum, widened to avoid overflow.
+ */
+long long fscl_lazy_stream_sum_int(const clazy_stream* stream, size_t threads);
+
+/**
+ * Find the minimum of a finite lazy integer stream.
+ *
+ * @param stream  The lazy integer stream.
+ * @param threads Number of participating threads, 0 for all pool workers.
+ * @param result  Receives the minimum.
+ * @return        True if the stream was not empty.
+ */
+bool fscl_lazy_stream_min_int(const clazy_stream* stream, size_t threads, int* result);
+
+/**
+ * Find the maximum of a finite lazy integer stream.
+ *
+ * @param stream  The lazy integer stream.
+ * @param threads Number of participating threads, 0 for all pool workers.
+ * @param result  Receives the maximum.
+ * @return        True if the stream was not empty.
+ */
+bool fscl_lazy_stream_max_int(const clazy_stream* stream, size_t threads, int* result);
+
+/**
+ * Count the elements of a finite lazy stream that satisfy a predicate.
+ *
+ * @param stream    The lazy stream.
+ * @param predicate The predicate, called once per element.
+ * @param threads   Number of participating threads, 0 for all pool workers.
+ * @return          Number of matching elements.
+ */
+size_t fscl_lazy_stream_count_if(const clazy_stream* stream, bool (*predicate)(clazy* item), size_t threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
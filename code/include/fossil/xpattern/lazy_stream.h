@@ -0,0 +1,87 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_LAZY_STREAM_H
+#define FSCL_LAZY_STREAM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "fossil/xpattern/lazy.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Read-ahead adapter over a lazy stream. A dedicated producer thread
+// generates up to `depth` elements ahead of the consumer into a
+// single-producer/single-consumer ring, so generation overlaps with
+// consumption. Exactly one thread may call fscl_lazy_prefetch_next.
+typedef struct {
+    clazy_stream stream; // Source stream
+    size_t depth;        // Ring capacity, rounded up to a power of two
+    void* state;         // Internal ring and producer thread
+} clazy_prefetch;
+
+// =================================================================
+// Create and Erase
+// =================================================================
+
+/**
+ * Create a prefetching reader over a lazy stream and start its producer.
+ * If no thread can be started the reader falls back to producing each
+ * element on demand.
+ *
+ * @param prefetch The prefetching reader to initialize.
+ * @param stream   The lazy stream to read ahead of.
+ * @param depth    Number of elements to produce ahead, 0 for the default.
+ * @return         True on success, false if allocation failed.
+ */
+bool fscl_lazy_prefetch_create(clazy_prefetch* prefetch, const clazy_stream* stream, size_t depth);
+
+/**
+ * Cancel the producer, wait for it to stop and erase every element that
+ * was produced but not consumed.
+ *
+ * @param prefetch The prefetching reader to erase.
+ */
+void fscl_lazy_prefetch_erase(clazy_prefetch* prefetch);
+
+// =================================================================
+// Additional Functions
+// =================================================================
+
+/**
+ * Take the next element of the stream, waiting for the producer if it has
+ * not caught up yet. The caller owns the element and erases it.
+ *
+ * @param prefetch The prefetching reader.
+ * @param out      Receives the next element.
+ * @return         True if an element was returned, false at the end of
+ *                 the stream or after cancellation.
+ */
+bool fscl_lazy_prefetch_next(clazy_prefetch* prefetch, clazy* out);
+
+/**
+ * Stop producing further elements. Elements already in the ring can still
+ * be erased with fscl_lazy_prefetch_erase; fscl_lazy_prefetch_next returns
+ * false from now on. Safe to call from any thread.
+ *
+ * @param prefetch The prefetching reader to cancel.
+ */
+void fscl_lazy_prefetch_cancel(clazy_prefetch* prefetch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
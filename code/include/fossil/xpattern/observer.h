@@ -18,18 +18,40 @@ extern "C"
 {
 #endif
 
+#include "fossil/xpattern/alloc.h"
+#include "fossil/xpattern/inline.h"
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+// Deferred event payload handed out by fscl_observe_notify_lazy. It is
+// built on the first fscl_observe_payload_get, shared by every observer
+// of the notification, and destroyed once the notification is over.
+typedef struct {
+    void* (*build)(void* context);                // Builds the payload
+    void (*destroy)(void* payload, void* context); // Releases it, may be NULL
+    void* context;                                // User context for both
+    void* value;                                  // The payload once built
+    bool built;
+} cpayload;
+
 // Structure representing an observer
 typedef struct {
     void (*update)(void* data); // Function pointer for the update method
 } cobserver;
 
+// Observer that receives deferred payloads. Register it with
+// fscl_observe_add_lazy_observer, which fills in `base`.
+typedef struct {
+    cobserver base;                     // Set up on registration
+    void (*update)(cpayload* payload);  // Receives the payload handle
+} cpayload_observer;
+
 // Structure representing the subject to be observed
 typedef struct {
-    cobserver** observers; // Array of observers
-    int numObservers;      // Number of observers
+    cobserver** observers;       // Array of observers
+    int numObservers;            // Number of observers
+    const callocator* allocator; // Owns the observer array
 } csubject;
 
 // =================================================================
@@ -43,6 +65,14 @@ typedef struct {
  */
 void fscl_observe_create(csubject* subject);
 
+/**
+ * Create a subject whose observer array comes from the given allocator.
+ *
+ * @param subject   The subject to create.
+ * @param allocator The allocator, or NULL for the heap.
+ */
+void fscl_observe_create_with(csubject* subject, const callocator* allocator);
+
 /**
  * Erase a subject and its observers.
  *
@@ -78,6 +108,24 @@ void fscl_observe_add_observer(csubject* subject, cobserver* observer);
  */
 void fscl_observe_remove_observer(csubject* subject, cobserver* observer);
 
+/**
+ * Add an observer of deferred payloads to the subject. It is notified in
+ * order with the other observers; fscl_observe_notify and
+ * fscl_observe_update_all hand it an already built payload.
+ *
+ * @param subject  The subject to which the observer is added.
+ * @param observer The observer to add.
+ */
+void fscl_observe_add_lazy_observer(csubject* subject, cpayload_observer* observer);
+
+/**
+ * Remove an observer of deferred payloads from the subject.
+ *
+ * @param subject  The subject from which the observer is removed.
+ * @param observer The observer to remove.
+ */
+void fscl_observe_remove_lazy_observer(csubject* subject, cpayload_observer* observer);
+
 /**
  * Notify all observers of the subject with the provided data.
  *
@@ -86,6 +134,30 @@ void fscl_observe_remove_observer(csubject* subject, cobserver* observer);
  */
 void fscl_observe_notify(csubject* subject, void* data);
 
+/**
+ * Notify all observers with a payload that is only built if one of them
+ * reads it. Observers added with fscl_observe_add_lazy_observer get the
+ * payload handle and call fscl_observe_payload_get if they need the data;
+ * plain observers force the payload and get it as before. Nothing is built
+ * when the subject has no observers.
+ *
+ * @param subject The subject whose observers need to be notified.
+ * @param build   Builds the payload from the context.
+ * @param destroy Releases the payload after the last observer, may be NULL.
+ * @param context User context passed to build and destroy.
+ */
+void fscl_observe_notify_lazy(csubject* subject, void* (*build)(void* context),
+                              void (*destroy)(void* payload, void* context), void* context);
+
+/**
+ * Get the payload of a deferred notification, building it on first use.
+ * The payload is only valid until the observer returns.
+ *
+ * @param payload The payload handle passed to a cpayload_observer.
+ * @return        The payload.
+ */
+void* fscl_observe_payload_get(cpayload* payload);
+
 /**
  * Erase all observers from the subject.
  *
@@ -99,7 +171,17 @@ void fscl_observe_erase_all(csubject* subject);
  * @param subject The subject to check for observers.
  * @return        1 if there are observers, 0 otherwise.
  */
-int fscl_observe_has_observers(csubject* subject);
+FSCL_INLINE_API int fscl_observe_has_observers(csubject* subject);
+
+// =================================================================
+// Inline Fast Paths (see inline.h)
+// =================================================================
+
+#ifdef FSCL_XPATTERN_INLINE
+inline int fscl_observe_has_observers(csubject* subject) {
+    return subject->numObservers > 0;
+}
+#endif
 
 #ifdef __cplusplus
 }
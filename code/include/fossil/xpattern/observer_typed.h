@@ -0,0 +1,168 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_OBSERVER_TYPED_H
+#define FSCL_OBSERVER_TYPED_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "fossil/xpattern/alloc.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+// Generators for subjects specialized on one payload type. Each expands to
+// static inline code for a prefix `name`:
+//
+//   name_update   void (*)(void* context, PAYLOAD payload)
+//   name_observer { update, context }, stored by value in the subject
+//   name_subject  the subject itself
+//   name_create, name_erase, name_add, name_remove, name_has_observers,
+//   name_notify
+//
+// PAYLOAD is `const payload_type*` for the plain generators and
+// `payload_type` for the _VALUE ones, which suit payloads of a few words.
+// The _FIXED generators keep up to `capacity` observers inside the subject
+// and never allocate; the others grow an array from the allocator that was
+// the default when the subject was created (see alloc.h).
+//
+//   FSCL_OBSERVE_DECLARE_FIXED_VALUE(temperature, int, 4)
+//   temperature_subject sensor;
+//   temperature_create(&sensor);
+//   temperature_add(&sensor, on_temperature, &display);
+//   temperature_notify(&sensor, 21);
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FSCL_OBSERVE_API_ static inline __attribute__((unused))
+#else
+#define FSCL_OBSERVE_API_ static inline
+#endif
+
+#define FSCL_OBSERVE_TYPES_(name, payload_param)                         \
+    typedef void (*name##_update)(void* context, payload_param payload);  \
+    typedef struct {                                                      \
+        name##_update update;                                             \
+        void* context;                                                    \
+    } name##_observer;
+
+// Shared by every variant; relies on the subject's observers and count.
+// Like fscl_observe_notify, notify re-reads both on every step, so an
+// observer may add or remove observers of the subject it is notified by.
+// An observer that removes itself shifts the next observer into its slot,
+// so that observer is skipped for the current round, again as in
+// fscl_observe_notify.
+#define FSCL_OBSERVE_COMMON_(name, payload_param)                                                       \
+    FSCL_OBSERVE_API_ bool name##_remove(name##_subject* subject, name##_update update, void* context) { \
+        for (size_t i = 0; i < subject->count; ++i) {                                                   \
+            if (subject->observers[i].update == update && subject->observers[i].context == context) {   \
+                memmove(&subject->observers[i], &subject->observers[i + 1],                             \
+                        (subject->count - i - 1) * sizeof(name##_observer));                            \
+                subject->count--;                                                                       \
+                return true;                                                                            \
+            }                                                                                           \
+        }                                                                                               \
+        return false;                                                                                   \
+    }                                                                                                   \
+    FSCL_OBSERVE_API_ bool name##_has_observers(const name##_subject* subject) {                        \
+        return subject->count > 0;                                                                      \
+    }                                                                                                   \
+    FSCL_OBSERVE_API_ void name##_notify(const name##_subject* subject, payload_param payload) {        \
+        for (size_t i = 0; i < subject->count; ++i) {                                                   \
+            name##_observer observer = subject->observers[i];                                           \
+            observer.update(observer.context, payload);                                                 \
+        }                                                                                               \
+    }
+
+#define FSCL_OBSERVE_HEAP_(name, payload_param)                                                           \
+    FSCL_OBSERVE_TYPES_(name, payload_param)                                                              \
+    typedef struct {                                                                                      \
+        name##_observer* observers;                                                                       \
+        size_t count;                                                                                     \
+        size_t capacity;                                                                                  \
+        const callocator* allocator;                                                                      \
+    } name##_subject;                                                                                     \
+    FSCL_OBSERVE_API_ void name##_create(name##_subject* subject) {                                       \
+        subject->observers = NULL;                                                                        \
+        subject->count = 0;                                                                               \
+        subject->capacity = 0;                                                                            \
+        subject->allocator = fscl_alloc_default();                                                        \
+    }                                                                                                     \
+    FSCL_OBSERVE_API_ void name##_erase(name##_subject* subject) {                                        \
+        fscl_free(subject->allocator, subject->observers, subject->capacity * sizeof(name##_observer));   \
+        subject->observers = NULL;                                                                        \
+        subject->count = 0;                                                                               \
+        subject->capacity = 0;                                                                            \
+    }                                                                                                     \
+    FSCL_OBSERVE_API_ bool name##_add(name##_subject* subject, name##_update update, void* context) {     \
+        if (subject->count == subject->capacity) {                                                        \
+            size_t capacity = subject->capacity ? subject->capacity * 2 : 4;                              \
+            name##_observer* observers = (name##_observer*)fscl_realloc(                                  \
+                subject->allocator, subject->observers, subject->capacity * sizeof(name##_observer),      \
+                capacity * sizeof(name##_observer));                                                      \
+            if (observers == NULL) {                                                                      \
+                return false;                                                                             \
+            }                                                                                             \
+            subject->observers = observers;                                                               \
+            subject->capacity = capacity;                                                                 \
+        }                                                                                                 \
+        subject->observers[subject->count].update = update;                                               \
+        subject->observers[subject->count].context = context;                                             \
+        subject->count++;                                                                                 \
+        return true;                                                                                      \
+    }                                                                                                     \
+    FSCL_OBSERVE_COMMON_(name, payload_param)
+
+#define FSCL_OBSERVE_FIXED_(name, payload_param, fixed_capacity)                                      \
+    FSCL_OBSERVE_TYPES_(name, payload_param)                                                          \
+    typedef struct {                                                                                  \
+        name##_observer observers[fixed_capacity];                                                    \
+        size_t count;                                                                                 \
+    } name##_subject;                                                                                 \
+    FSCL_OBSERVE_API_ void name##_create(name##_subject* subject) {                                   \
+        subject->count = 0;                                                                           \
+    }                                                                                                 \
+    FSCL_OBSERVE_API_ void name##_erase(name##_subject* subject) {                                    \
+        subject->count = 0;                                                                           \
+    }                                                                                                 \
+    FSCL_OBSERVE_API_ bool name##_add(name##_subject* subject, name##_update update, void* context) { \
+        if (subject->count == (fixed_capacity)) {                                                     \
+            return false;                                                                             \
+        }                                                                                             \
+        subject->observers[subject->count].update = update;                                           \
+        subject->observers[subject->count].context = context;                                        \
+        subject->count++;                                                                             \
+        return true;                                                                                  \
+    }                                                                                                 \
+    FSCL_OBSERVE_COMMON_(name, payload_param)
+
+// Growable subject, payload passed as a const pointer
+#define FSCL_OBSERVE_DECLARE(name, payload_type) FSCL_OBSERVE_HEAP_(name, const payload_type*)
+
+// Growable subject, payload passed by value
+#define FSCL_OBSERVE_DECLARE_VALUE(name, payload_type) FSCL_OBSERVE_HEAP_(name, payload_type)
+
+// Subject with room for `capacity` observers, payload passed as a const pointer
+#define FSCL_OBSERVE_DECLARE_FIXED(name, payload_type, capacity) \
+    FSCL_OBSERVE_FIXED_(name, const payload_type*, capacity)
+
+// Subject with room for `capacity` observers, payload passed by value
+#define FSCL_OBSERVE_DECLARE_FIXED_VALUE(name, payload_type, capacity) \
+    FSCL_OBSERVE_FIXED_(name, payload_type, capacity)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
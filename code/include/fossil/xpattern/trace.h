@@ -0,0 +1,120 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_TRACE_H
+#define FSCL_TRACE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Trace modes selected with the meson `trace` option. With usdt the library
+// carries SystemTap/USDT probes (provider fscl_xpattern) that cost a single
+// nop until perf, bpftrace or stap attaches; with ring the same probe points
+// record into per-thread ring buffers; with none they compile to nothing.
+#define FSCL_TRACE_NONE 0
+#define FSCL_TRACE_USDT 1
+#define FSCL_TRACE_RING 2
+
+// Default number of records each thread's ring holds (a power of two)
+#ifndef FSCL_TRACE_RING_SIZE
+#define FSCL_TRACE_RING_SIZE 4096
+#endif
+
+// Probe points of the library, and the first id free for application events.
+// USDT probe names and arguments are given in brackets.
+typedef enum {
+    CTRACE_NOTIFY_BEGIN = 1,   // [notify_begin] subject, observer count
+    CTRACE_NOTIFY_END,         // [notify_end] subject, observer count
+    CTRACE_OBSERVER_DISPATCH,  // [observer_dispatch] subject, observer
+    CTRACE_LAZY_FORCE_BEGIN,   // [lazy_force_begin] lazy, type
+    CTRACE_LAZY_FORCE_END,     // [lazy_force_end] lazy, type
+    CTRACE_CONTRACT_VIOLATION, // [contract_violation] kind, message, file, line
+                               // (the ring keeps message and line)
+    CTRACE_USER = 256
+} ctrace_event;
+
+// One recorded event. Dump files start with the 16-byte header
+// "FTRC", version, record size and record count (native-endian uint32)
+// followed by the records in this layout, oldest first.
+typedef struct {
+    uint64_t time_ns;  // Monotonic timestamp
+    uint32_t thread;   // Small id of the recording thread
+    uint32_t event;    // ctrace_event
+    uint64_t arg0;
+    uint64_t arg1;
+} ctrace_record;
+
+// =================================================================
+// Recording
+// =================================================================
+
+/**
+ * Trace mode the library was built with.
+ *
+ * @return FSCL_TRACE_NONE, FSCL_TRACE_USDT or FSCL_TRACE_RING.
+ */
+int fscl_trace_mode(void);
+
+/**
+ * Pause or resume recording into the rings. Recording starts enabled.
+ *
+ * @param enabled False to drop events until enabled again.
+ */
+void fscl_trace_enable(bool enabled);
+
+/**
+ * Record an event into the calling thread's ring. Works in every trace
+ * mode, so applications can add their own events from CTRACE_USER on.
+ *
+ * @param event The event id.
+ * @param arg0  First argument.
+ * @param arg1  Second argument.
+ */
+void fscl_trace_record(uint32_t event, uint64_t arg0, uint64_t arg1);
+
+// =================================================================
+// Inspection
+// =================================================================
+
+/**
+ * Copy the newest recorded events of all threads, oldest first.
+ *
+ * @param records  Destination array.
+ * @param capacity Number of records the array holds.
+ * @return         Number of records copied.
+ */
+size_t fscl_trace_snapshot(ctrace_record* records, size_t capacity);
+
+/**
+ * Write every recorded event to a binary dump file.
+ *
+ * @param path Path of the file to create.
+ * @return     True if the file was written.
+ */
+bool fscl_trace_dump(const char* path);
+
+/**
+ * Forget every recorded event.
+ */
+void fscl_trace_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,203 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/alloc.h"
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ALLOC_ALIGN alignof(max_align_t)
+#define ALLOC_ROUND(n) (((n) + ALLOC_ALIGN - 1) & ~(size_t)(ALLOC_ALIGN - 1))
+
+static void *heap_alloc(void *context, size_t size) {
+    (void)context;
+    return malloc(size);
+}
+
+static void *heap_realloc(void *context, void *ptr, size_t old_size, size_t new_size) {
+    (void)context;
+    (void)old_size;
+    return realloc(ptr, new_size);
+}
+
+static void heap_free(void *context, void *ptr, size_t size) {
+    (void)context;
+    (void)size;
+    free(ptr);
+}
+
+static const callocator heap_allocator = { heap_alloc, heap_realloc, heap_free, NULL };
+
+static _Atomic(const callocator *) default_allocator = &heap_allocator;
+
+void fscl_alloc_set_default(const callocator *allocator) {
+    atomic_store_explicit(&default_allocator, allocator != NULL ? allocator : &heap_allocator, memory_order_release);
+}
+
+const callocator *fscl_alloc_default(void) {
+    return atomic_load_explicit(&default_allocator, memory_order_acquire);
+}
+
+const callocator *fscl_alloc_heap(void) {
+    return &heap_allocator;
+}
+
+void *fscl_alloc(const callocator *allocator, size_t size) {
+    if (allocator == NULL) {
+        return malloc(size);
+    }
+    return allocator->alloc(allocator->context, size);
+}
+
+void *fscl_realloc(const callocator *allocator, void *ptr, size_t old_size, size_t new_size) {
+    if (allocator == NULL) {
+        return realloc(ptr, new_size);
+    }
+    if (ptr == NULL) {
+        return allocator->alloc(allocator->context, new_size);
+    }
+    if (allocator->realloc != NULL) {
+        return allocator->realloc(allocator->context, ptr, old_size, new_size);
+    }
+    void *moved = allocator->alloc(allocator->context, new_size);
+    if (moved != NULL) {
+        memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+        fscl_free(allocator, ptr, old_size);
+    }
+    return moved;
+}
+
+void fscl_free(const callocator *allocator, void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return;
+    }
+    if (allocator == NULL) {
+        free(ptr);
+    } else if (allocator->free != NULL) {
+        allocator->free(allocator->context, ptr, size);
+    }
+}
+
+// =================================================================
+// Bump arena
+// =================================================================
+
+static void *arena_alloc(void *context, size_t size) {
+    calloc_arena *arena = context;
+    size_t offset = ALLOC_ROUND(arena->used);
+    if (offset > arena->capacity || size > arena->capacity - offset) {
+        return NULL;
+    }
+    arena->last = offset;
+    arena->used = offset + size;
+    return arena->base + offset;
+}
+
+static bool arena_is_last(const calloc_arena *arena, const void *ptr) {
+    return (const unsigned char *)ptr == arena->base + arena->last && arena->used > arena->last;
+}
+
+static void *arena_realloc(void *context, void *ptr, size_t old_size, size_t new_size) {
+    calloc_arena *arena = context;
+    if (arena_is_last(arena, ptr)) {
+        if (new_size > arena->capacity - arena->last) {
+            return NULL;
+        }
+        arena->used = arena->last + new_size;
+        return ptr;
+    }
+    void *moved = arena_alloc(arena, new_size);
+    if (moved != NULL) {
+        memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    }
+    return moved;
+}
+
+// Only the most recent block gives its space back
+static void arena_free(void *context, void *ptr, size_t size) {
+    calloc_arena *arena = context;
+    (void)size;
+    if (arena_is_last(arena, ptr)) {
+        arena->used = arena->last;
+    }
+}
+
+void fscl_alloc_arena_init(calloc_arena *arena, void *buffer, size_t capacity) {
+    // Align the start so every block is suitably aligned for any type
+    uintptr_t address = (uintptr_t)buffer;
+    size_t skew = (size_t)(ALLOC_ROUND(address) - address);
+    arena->base = (unsigned char *)buffer + (skew < capacity ? skew : capacity);
+    arena->capacity = skew < capacity ? capacity - skew : 0;
+    arena->used = 0;
+    arena->last = 0;
+    arena->allocator = (callocator){ arena_alloc, arena_realloc, arena_free, arena };
+}
+
+void fscl_alloc_arena_reset(calloc_arena *arena) {
+    arena->used = 0;
+    arena->last = 0;
+}
+
+// =================================================================
+// Fixed-size pool
+// =================================================================
+
+static void *pool_alloc(void *context, size_t size) {
+    calloc_pool *pool = context;
+    if (size > pool->block_size || pool->free_list == NULL) {
+        return NULL;
+    }
+    void *block = pool->free_list;
+    memcpy(&pool->free_list, block, sizeof(void *));
+    return block;
+}
+
+static void *pool_realloc(void *context, void *ptr, size_t old_size, size_t new_size) {
+    calloc_pool *pool = context;
+    (void)old_size;
+    return new_size <= pool->block_size ? ptr : NULL;
+}
+
+static void pool_free(void *context, void *ptr, size_t size) {
+    calloc_pool *pool = context;
+    (void)size;
+    memcpy(ptr, &pool->free_list, sizeof(void *));
+    pool->free_list = ptr;
+}
+
+bool fscl_alloc_pool_init(calloc_pool *pool, void *buffer, size_t capacity, size_t block_size) {
+    uintptr_t address = (uintptr_t)buffer;
+    size_t skew = (size_t)(ALLOC_ROUND(address) - address);
+    size_t stride = ALLOC_ROUND(block_size < sizeof(void *) ? sizeof(void *) : block_size);
+
+    pool->base = (unsigned char *)buffer + (skew < capacity ? skew : capacity);
+    pool->block_size = stride;
+    pool->block_count = skew < capacity ? (capacity - skew) / stride : 0;
+    pool->free_list = NULL;
+    pool->allocator = (callocator){ pool_alloc, pool_realloc, pool_free, pool };
+
+    // Thread the free list front to back so blocks are handed out in order
+    for (size_t i = pool->block_count; i > 0; --i) {
+        pool_free(pool, pool->base + (i - 1) * stride, stride);
+    }
+    return pool->block_count > 0;
+}
+
+size_t fscl_alloc_pool_available(const calloc_pool *pool) {
+    size_t count = 0;
+    for (void *block = pool->free_list; block != NULL; memcpy(&block, block, sizeof(void *))) {
+        count++;
+    }
+    return count;
+}
@@ -10,29 +10,148 @@ Description:
     feel free to contact Michael at michaelbrockus@gmail.com.
 ==============================================================================
 */
+#define _POSIX_C_SOURCE 200809L
+#define _DARWIN_C_SOURCE
+#ifndef FSCL_XPATTERN_INLINE
+#define FSCL_XPATTERN_INLINE
+#endif
 #include "fossil/xpattern/contract.h"
+#include "fossil/xpattern/contract_report.h"
+#include "fossil/xpattern/contract_sample.h"
+#include "xthread.h"
+#include "xtrace.h"
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+// Global registry; slot id - 1 holds the contract with that id
+static struct {
+    fscl_mutex_t lock;
+    _Atomic(ccontract *) slots[FSCL_CONTRACT_REGISTRY_CAPACITY];
+    size_t hint;
+} registry = { .lock = FSCL_MUTEX_INITIALIZER };
+
+void fscl_contract_init(ccontract *contract, bool (*pre_condition)(), void (*post_condition)()) {
+    contract->pre_condition = pre_condition;
+    contract->post_condition = post_condition;
+    contract->disabled = false;
+    contract->id = 0;
+    contract->name = NULL;
+    contract->allocator = NULL;
+}
+
 ccontract *fscl_contract_create(bool (*pre_condition)(), void (*post_condition)()) {
-    ccontract *contract = (ccontract *)malloc(sizeof(ccontract));
+    return fscl_contract_create_with(pre_condition, post_condition, fscl_alloc_default());
+}
+
+ccontract *fscl_contract_create_with(bool (*pre_condition)(), void (*post_condition)(), const callocator *allocator) {
+    ccontract *contract = (ccontract *)fscl_alloc(allocator, sizeof(ccontract));
     if (contract != NULL) {
-        contract->pre_condition = pre_condition;
-        contract->post_condition = post_condition;
+        fscl_contract_init(contract, pre_condition, post_condition);
+        contract->allocator = allocator != NULL ? allocator : fscl_alloc_heap();
     }
     return contract;
 }
 
+void fscl_contract_destroy(ccontract *contract) {
+    // Only created contracts carry an allocator; anything else is not ours
+    if (contract != NULL && contract->allocator != NULL) {
+        fscl_contract_registry_remove(contract);
+        fscl_free(contract->allocator, contract, sizeof(ccontract));
+    }
+}
+
+void fscl_contract_arena_init(ccontract_arena *arena, ccontract *storage, size_t capacity) {
+    arena->slots = storage;
+    arena->capacity = capacity;
+    arena->used = 0;
+}
+
+ccontract *fscl_contract_arena_create(ccontract_arena *arena, bool (*pre_condition)(), void (*post_condition)()) {
+    if (arena->used == arena->capacity) {
+        return NULL;
+    }
+    ccontract *contract = &arena->slots[arena->used++];
+    fscl_contract_init(contract, pre_condition, post_condition);
+    return contract;
+}
+
+void fscl_contract_arena_reset(ccontract_arena *arena) {
+    arena->used = 0;
+}
+
+size_t fscl_contract_registry_add(ccontract *contract, const char *name) {
+    fscl_mutex_lock(&registry.lock);
+    if (contract->id != 0) {
+        contract->name = name;
+        fscl_mutex_unlock(&registry.lock);
+        return contract->id;
+    }
+    for (size_t n = 0; n < FSCL_CONTRACT_REGISTRY_CAPACITY; ++n) {
+        size_t slot = (registry.hint + n) % FSCL_CONTRACT_REGISTRY_CAPACITY;
+        if (atomic_load_explicit(&registry.slots[slot], memory_order_relaxed) == NULL) {
+            contract->name = name;
+            contract->id = slot + 1;
+            atomic_store_explicit(&registry.slots[slot], contract, memory_order_release);
+            registry.hint = slot + 1;
+            fscl_mutex_unlock(&registry.lock);
+            return contract->id;
+        }
+    }
+    fscl_mutex_unlock(&registry.lock);
+    return 0;
+}
+
+void fscl_contract_registry_remove(ccontract *contract) {
+    fscl_mutex_lock(&registry.lock);
+    if (contract->id != 0) {
+        atomic_store_explicit(&registry.slots[contract->id - 1], NULL, memory_order_release);
+        contract->id = 0;
+    }
+    fscl_mutex_unlock(&registry.lock);
+}
+
+ccontract *fscl_contract_registry_lookup(size_t id) {
+    if (id == 0 || id > FSCL_CONTRACT_REGISTRY_CAPACITY) {
+        return NULL;
+    }
+    return atomic_load_explicit(&registry.slots[id - 1], memory_order_acquire);
+}
+
+ccontract *fscl_contract_registry_find(const char *name) {
+    ccontract *found = NULL;
+    fscl_mutex_lock(&registry.lock);
+    for (size_t slot = 0; slot < FSCL_CONTRACT_REGISTRY_CAPACITY && found == NULL; ++slot) {
+        ccontract *contract = atomic_load_explicit(&registry.slots[slot], memory_order_relaxed);
+        if (contract != NULL && contract->name != NULL && strcmp(contract->name, name) == 0) {
+            found = contract;
+        }
+    }
+    fscl_mutex_unlock(&registry.lock);
+    return found;
+}
+
+bool fscl_contract_registry_enable(size_t id, bool enabled) {
+    ccontract *contract = fscl_contract_registry_lookup(id);
+    if (contract == NULL) {
+        return false;
+    }
+    __atomic_store_n(&contract->disabled, !enabled, __ATOMIC_RELAXED);
+    return true;
+}
+
 bool fscl_contract_check_pre(ccontract *contract) {
-    if (contract != NULL && contract->pre_condition != NULL) {
+    if (contract != NULL && contract->pre_condition != NULL &&
+        !__atomic_load_n(&contract->disabled, __ATOMIC_RELAXED)) {
         return contract->pre_condition();
     }
     return true;
 }
 
 bool fscl_contract_check_post(ccontract *contract) {
-    if (contract != NULL && contract->post_condition != NULL) {
+    if (contract != NULL && contract->post_condition != NULL &&
+        !__atomic_load_n(&contract->disabled, __ATOMIC_RELAXED)) {
         contract->post_condition();
     }
     return true;
@@ -40,50 +159,80 @@ bool fscl_contract_check_post(ccontract *contract) {
 
 bool fscl_contract_assert(bool condition, const char *message) {
     if (!condition) {
-        fprintf(stderr, "[ERROR] Contract Violation: %s\n", message);
+        FSCL_TRACE_CONTRACT_VIOLATION("assert", message, NULL, 0);
+        if (!fscl_contract_report_submit("assert", message, NULL, 0)) {
+            fprintf(stderr, "[ERROR] Contract Violation: %s\n", message);
+        }
         return false;
     }
     return true;
 }
 
+bool fscl_contract_fail(const char *kind, const char *message, const char *file, int line) {
+    FSCL_TRACE_CONTRACT_VIOLATION(kind, message, file, line);
+    if (!fscl_contract_report_submit(kind, message, file, line)) {
+        fprintf(stderr, "[ERROR] Contract Violation: %s (%s at %s:%d)\n", message, kind, file, line);
+    }
+    return false;
+}
+
+bool fscl_contract_string_length_within(const char *str, size_t min_length, size_t max_length) {
+    size_t length = (str != NULL) ? strlen(str) : 0;
+    return length >= min_length && length <= max_length;
+}
+
+// Each requirement is one implicit site when profiling is compiled in
+#define CONTRACT_REQUIRE_(site_name, cond, param_name) \
+    fscl_contract_assert(FSCL_CONTRACT_IMPLICIT_SITE_(site_name, (cond)), param_name)
+
+#if FSCL_CONTRACT_PROFILE
 bool fscl_contract_require_not_null(const void *ptr, const char *param_name) {
-    return fscl_contract_assert(ptr != NULL, param_name);
+    return CONTRACT_REQUIRE_("require_not_null", ptr != NULL, param_name);
 }
 
 bool fscl_contract_require_positive(int value, const char *param_name) {
-    return fscl_contract_assert(value > 0, param_name);
+    return CONTRACT_REQUIRE_("require_positive", value > 0, param_name);
 }
 
 bool fscl_contract_require_non_negative(int value, const char *param_name) {
-    return fscl_contract_assert(value >= 0, param_name);
+    return CONTRACT_REQUIRE_("require_non_negative", value >= 0, param_name);
 }
 
 bool fscl_contract_require_within_range(int value, int min, int max, const char *param_name) {
-    return fscl_contract_assert(value >= min && value <= max, param_name);
+    return CONTRACT_REQUIRE_("require_within_range", value >= min && value <= max, param_name);
 }
 
 bool fscl_contract_require_within_double_range(double value, double min, double max, const char *param_name) {
-    return fscl_contract_assert(value >= min && value <= max, param_name);
+    return CONTRACT_REQUIRE_("require_within_double_range", value >= min && value <= max, param_name);
 }
 
-bool fscl_contract_require_string_length(const char *str, size_t min_length, size_t max_length, const char *param_name) {
-    size_t length = (str != NULL) ? strlen(str) : 0;
-    return fscl_contract_assert(length >= min_length && length <= max_length, param_name);
+bool fscl_contract_require_pointer_equality(const void *ptr1, const void *ptr2, const char *param_name) {
+    return CONTRACT_REQUIRE_("require_pointer_equality", ptr1 == ptr2, param_name);
 }
+#else
+// External definitions of the inline fast paths in contract.h
+extern inline bool fscl_contract_require_not_null(const void *ptr, const char *param_name);
+extern inline bool fscl_contract_require_positive(int value, const char *param_name);
+extern inline bool fscl_contract_require_non_negative(int value, const char *param_name);
+extern inline bool fscl_contract_require_within_range(int value, int min, int max, const char *param_name);
+extern inline bool fscl_contract_require_within_double_range(double value, double min, double max, const char *param_name);
+extern inline bool fscl_contract_require_pointer_equality(const void *ptr1, const void *ptr2, const char *param_name);
+#endif
 
-bool fscl_contract_require_pointer_equality(const void *ptr1, const void *ptr2, const char *param_name) {
-    return fscl_contract_assert(ptr1 == ptr2, param_name);
+bool fscl_contract_require_string_length(const char *str, size_t min_length, size_t max_length, const char *param_name) {
+    return CONTRACT_REQUIRE_("require_string_length", fscl_contract_string_length_within(str, min_length, max_length),
+                             param_name);
 }
 
 bool fscl_contract_require_string_equality(const char *str1, const char *str2, const char *param_name) {
-    return fscl_contract_assert(strcmp(str1, str2) == 0, param_name);
+    return CONTRACT_REQUIRE_("require_string_equality", strcmp(str1, str2) == 0, param_name);
 }
 
 bool fscl_contract_require_array_length(const void *array, size_t expected_length, size_t element_size, const char *param_name) {
     size_t actual_length = (array != NULL) ? (strlen(array) / element_size) : 0;
-    return fscl_contract_assert(actual_length == expected_length, param_name);
+    return CONTRACT_REQUIRE_("require_array_length", actual_length == expected_length, param_name);
 }
 
 bool fscl_contract_require_custom_condition(bool (*custom_condition)(), const char *param_name) {
-    return fscl_contract_assert(custom_condition(), param_name);
+    return CONTRACT_REQUIRE_("require_custom_condition", custom_condition(), param_name);
 }
@@ -0,0 +1,524 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#define _POSIX_C_SOURCE 200809L
+#define _DARWIN_C_SOURCE
+#include "fossil/xpattern/contract_report.h"
+#include "xthread.h"
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define REPORT_MESSAGE_SIZE 96
+#define REPORT_LINE_SIZE 256
+#define REPORT_DEFAULT_RING 256
+#define REPORT_DEFAULT_RATE 10
+#define REPORT_DEFAULT_BURST 10
+#define REPORT_DEFAULT_INTERVAL 100
+#define REPORT_BATCH_SIZE 32
+
+typedef struct {
+    const char *kind;
+    const char *file;
+    int line;
+    char message[REPORT_MESSAGE_SIZE];
+} report_entry;
+
+// Single-producer ring owned by one thread; only the reporter consumes it.
+// Rings outlive start/stop and are freed once their thread has exited.
+typedef struct report_ring {
+    struct report_ring *next;
+    atomic_size_t head;
+    char head_pad[64 - sizeof(atomic_size_t)];
+    atomic_size_t tail;
+    atomic_ullong dropped;
+    atomic_bool abandoned;
+    size_t mask;
+    report_entry entries[];
+} report_ring;
+
+// Aggregated state of one call site, owned by the reporter
+typedef struct {
+    const char *kind;
+    const char *file;
+    int line;
+    char message[REPORT_MESSAGE_SIZE];
+    size_t hash;
+    bool used;
+    unsigned long long occurrences;
+    unsigned long long pending;
+    double tokens;
+    unsigned long long refilled_at;
+} report_site;
+
+typedef enum { REPORT_SINK_FD, REPORT_SINK_CALLBACK, REPORT_SINK_MEMORY } report_sink_kind;
+
+// Callback reports drained under the lock and delivered after releasing it
+typedef struct {
+    ccontract_report_fn callback;
+    void *context;
+    ccontract_violation violation;
+    char message[REPORT_MESSAGE_SIZE];
+} report_pending;
+
+typedef struct {
+    size_t count;
+    report_pending items[REPORT_BATCH_SIZE];
+} report_batch;
+
+static struct {
+    fscl_mutex_t lock;
+    fscl_cond_t wake;
+    fscl_cond_t delivered;
+    fscl_thread_t thread;
+    atomic_bool running;
+    bool stopping;
+    bool key_ready;
+    fscl_tls_t key;
+    report_ring *rings;
+    ccontract_report_config config;
+
+    report_sink_kind sink;
+    ccontract_report_fn callback;
+    void *context;
+    int fd;
+    char *memory;
+    size_t memory_size;
+    size_t memory_length;
+
+    report_site *sites;
+    size_t site_mask;
+    size_t site_count;
+    unsigned long long violations;
+    unsigned long long reported;
+    unsigned long long suppressed;
+    unsigned long long retired_dropped;
+    size_t delivering;  // Batches being handed to callbacks outside the lock
+} reporter = { .lock = FSCL_MUTEX_INITIALIZER, .wake = FSCL_COND_INITIALIZER, .delivered = FSCL_COND_INITIALIZER,
+               .sink = REPORT_SINK_FD, .fd = 2 };
+
+// Set while this thread runs a report callback
+static _Thread_local bool report_in_callback = false;
+
+// =================================================================
+// Producer side
+// =================================================================
+
+static void report_abandon(void *value) {
+    report_ring *ring = value;
+    atomic_store_explicit(&ring->abandoned, true, memory_order_release);
+}
+
+static report_ring *report_attach(void) {
+    size_t capacity = 1;
+    while (capacity < reporter.config.ring_size) {
+        capacity <<= 1;
+    }
+
+    report_ring *ring = malloc(sizeof(report_ring) + capacity * sizeof(report_entry));
+    if (ring == NULL) {
+        return NULL;
+    }
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->dropped, 0);
+    atomic_init(&ring->abandoned, false);
+    ring->mask = capacity - 1;
+
+    fscl_mutex_lock(&reporter.lock);
+    ring->next = reporter.rings;
+    reporter.rings = ring;
+    fscl_mutex_unlock(&reporter.lock);
+
+    fscl_tls_set(reporter.key, ring);
+    return ring;
+}
+
+bool fscl_contract_report_submit(const char *kind, const char *message, const char *file, int line) {
+    if (!atomic_load_explicit(&reporter.running, memory_order_acquire)) {
+        return false;
+    }
+
+    report_ring *ring = fscl_tls_get(reporter.key);
+    if (ring == NULL && (ring = report_attach()) == NULL) {
+        return false;
+    }
+
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (tail - atomic_load_explicit(&ring->head, memory_order_acquire) > ring->mask) {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        return true;
+    }
+
+    report_entry *entry = &ring->entries[tail & ring->mask];
+    entry->kind = kind;
+    entry->file = file;
+    entry->line = line;
+    size_t length = 0;
+    if (message != NULL) {
+        while (length < REPORT_MESSAGE_SIZE - 1 && message[length] != '\0') {
+            entry->message[length] = message[length];
+            length++;
+        }
+    }
+    entry->message[length] = '\0';
+
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+// =================================================================
+// Reporter side (under reporter.lock, except callback delivery)
+// =================================================================
+
+static bool report_write_fd(int fd, const char *data, size_t length) {
+    while (length > 0) {
+#ifdef _WIN32
+        int written = _write(fd, data, (unsigned int)length);
+#else
+        ssize_t written = write(fd, data, length);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+static void report_emit(const ccontract_violation *violation, report_batch *batch) {
+    if (reporter.sink == REPORT_SINK_CALLBACK) {
+        // The ring slot is reused once drained, so the message is copied
+        report_pending *pending = &batch->items[batch->count++];
+        pending->callback = reporter.callback;
+        pending->context = reporter.context;
+        pending->violation = *violation;
+        memcpy(pending->message, violation->message, sizeof(pending->message));
+        pending->violation.message = pending->message;
+        return;
+    }
+
+    // Leave room for the newline; long lines are truncated
+    char line[REPORT_LINE_SIZE];
+    size_t room = sizeof(line) - 1;
+    int length;
+    if (violation->file != NULL) {
+        length = snprintf(line, room, "[ERROR] Contract Violation: %s (%s at %s:%d)", violation->message,
+                          violation->kind, violation->file, violation->line);
+    } else {
+        length = snprintf(line, room, "[ERROR] Contract Violation: %s (%s)", violation->message, violation->kind);
+    }
+    size_t used = length < 0 ? 0 : ((size_t)length < room ? (size_t)length : room - 1);
+    if (violation->suppressed > 0 && used < room - 1) {
+        length = snprintf(line + used, room - used, " [%llu suppressed]", violation->suppressed);
+        used += length < 0 ? 0 : ((size_t)length < room - used ? (size_t)length : room - used - 1);
+    }
+    line[used++] = '\n';
+
+    if (reporter.sink == REPORT_SINK_FD) {
+        report_write_fd(reporter.fd, line, used);
+    } else if (reporter.memory_length + used < reporter.memory_size) {
+        memcpy(reporter.memory + reporter.memory_length, line, used);
+        reporter.memory_length += used;
+        reporter.memory[reporter.memory_length] = '\0';
+    }
+}
+
+static size_t report_hash(const report_entry *entry) {
+    size_t hash = (size_t)14695981039346656037ULL;
+    for (const char *c = entry->message; *c != '\0'; ++c) {
+        hash = (hash ^ (unsigned char)*c) * (size_t)1099511628211ULL;
+    }
+    hash ^= (size_t)(uintptr_t)entry->file;
+    hash ^= (size_t)entry->line * (size_t)0x9E3779B97F4A7C15ULL;
+    return hash;
+}
+
+static bool report_grow_sites(void) {
+    size_t slots = reporter.sites != NULL ? (reporter.site_mask + 1) * 2 : 64;
+    report_site *sites = calloc(slots, sizeof(report_site));
+    if (sites == NULL) {
+        return false;
+    }
+    if (reporter.sites != NULL) {
+        for (size_t i = 0; i <= reporter.site_mask; ++i) {
+            if (reporter.sites[i].used) {
+                size_t slot = reporter.sites[i].hash & (slots - 1);
+                while (sites[slot].used) {
+                    slot = (slot + 1) & (slots - 1);
+                }
+                sites[slot] = reporter.sites[i];
+            }
+        }
+        free(reporter.sites);
+    }
+    reporter.sites = sites;
+    reporter.site_mask = slots - 1;
+    return true;
+}
+
+static report_site *report_find_site(const report_entry *entry, unsigned long long now) {
+    if ((reporter.site_count + 1) * 4 > (reporter.sites != NULL ? reporter.site_mask + 1 : 0) * 3 &&
+        !report_grow_sites()) {
+        return NULL;
+    }
+
+    size_t hash = report_hash(entry);
+    size_t slot = hash & reporter.site_mask;
+    while (reporter.sites[slot].used) {
+        report_site *site = &reporter.sites[slot];
+        if (site->hash == hash && site->file == entry->file && site->line == entry->line &&
+            strcmp(site->message, entry->message) == 0) {
+            return site;
+        }
+        slot = (slot + 1) & reporter.site_mask;
+    }
+
+    report_site *site = &reporter.sites[slot];
+    site->kind = entry->kind;
+    site->file = entry->file;
+    site->line = entry->line;
+    memcpy(site->message, entry->message, sizeof(site->message));
+    site->hash = hash;
+    site->used = true;
+    site->occurrences = 0;
+    site->pending = 0;
+    site->tokens = (double)reporter.config.burst;
+    site->refilled_at = now;
+    reporter.site_count++;
+    return site;
+}
+
+static void report_process(const report_entry *entry, report_batch *batch) {
+    unsigned long long now = fscl_time_ns();
+    report_site *site = report_find_site(entry, now);
+    reporter.violations++;
+
+    ccontract_violation violation = { entry->kind, entry->message, entry->file, entry->line, 1, 0 };
+    if (site != NULL) {
+        site->occurrences++;
+        site->tokens += (double)(now - site->refilled_at) * reporter.config.rate_per_second / 1e9;
+        if (site->tokens > reporter.config.burst) {
+            site->tokens = reporter.config.burst;
+        }
+        site->refilled_at = now;
+        if (site->tokens < 1.0) {
+            site->pending++;
+            reporter.suppressed++;
+            return;
+        }
+        site->tokens -= 1.0;
+        violation.occurrences = site->occurrences;
+        violation.suppressed = site->pending;
+        site->pending = 0;
+    }
+
+    reporter.reported++;
+    report_emit(&violation, batch);
+}
+
+// Process queued entries until the batch is full; true if it filled up
+static bool report_collect_locked(report_batch *batch) {
+    report_ring **link = &reporter.rings;
+    while (*link != NULL) {
+        report_ring *ring = *link;
+        size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        for (; head != tail && batch->count < REPORT_BATCH_SIZE; ++head) {
+            report_process(&ring->entries[head & ring->mask], batch);
+        }
+        atomic_store_explicit(&ring->head, head, memory_order_release);
+        if (batch->count == REPORT_BATCH_SIZE) {
+            return true;
+        }
+
+        // The owning thread has exited, so nothing can be pushed any more
+        if (atomic_load_explicit(&ring->abandoned, memory_order_acquire) &&
+            atomic_load_explicit(&ring->tail, memory_order_acquire) == head) {
+            reporter.retired_dropped += atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+            *link = ring->next;
+            free(ring);
+            continue;
+        }
+        link = &ring->next;
+    }
+    return false;
+}
+
+// Drain every ring. Callbacks run with the lock released, so they may call
+// back into the reporter; the lock is held again on return.
+static void report_drain_locked(void) {
+    report_batch batch;
+    bool more;
+    do {
+        batch.count = 0;
+        more = report_collect_locked(&batch);
+        if (batch.count == 0) {
+            break;
+        }
+
+        reporter.delivering++;
+        fscl_mutex_unlock(&reporter.lock);
+        bool nested = report_in_callback;
+        report_in_callback = true;
+        for (size_t i = 0; i < batch.count; ++i) {
+            batch.items[i].callback(&batch.items[i].violation, batch.items[i].context);
+        }
+        report_in_callback = nested;
+        fscl_mutex_lock(&reporter.lock);
+        if (--reporter.delivering == 0) {
+            fscl_cond_broadcast(&reporter.delivered);
+        }
+    } while (more);
+}
+
+static void report_run(void *arg) {
+    (void)arg;
+    fscl_mutex_lock(&reporter.lock);
+    while (!reporter.stopping) {
+        fscl_cond_timedwait_ms(&reporter.wake, &reporter.lock, reporter.config.flush_interval_ms);
+        report_drain_locked();
+    }
+    fscl_mutex_unlock(&reporter.lock);
+}
+
+// =================================================================
+// Public API
+// =================================================================
+
+bool fscl_contract_report_start(const ccontract_report_config *config) {
+    fscl_mutex_lock(&reporter.lock);
+    if (atomic_load(&reporter.running)) {
+        fscl_mutex_unlock(&reporter.lock);
+        return true;
+    }
+    if (!reporter.key_ready && !(reporter.key_ready = fscl_tls_create(&reporter.key, report_abandon))) {
+        fscl_mutex_unlock(&reporter.lock);
+        return false;
+    }
+
+    ccontract_report_config settings = config != NULL ? *config : (ccontract_report_config){ 0, 0, 0, 0 };
+    reporter.config.ring_size = settings.ring_size ? settings.ring_size : REPORT_DEFAULT_RING;
+    reporter.config.rate_per_second = settings.rate_per_second ? settings.rate_per_second : REPORT_DEFAULT_RATE;
+    reporter.config.burst = settings.burst ? settings.burst : REPORT_DEFAULT_BURST;
+    reporter.config.flush_interval_ms = settings.flush_interval_ms ? settings.flush_interval_ms : REPORT_DEFAULT_INTERVAL;
+    reporter.violations = 0;
+    reporter.reported = 0;
+    reporter.suppressed = 0;
+    reporter.stopping = false;
+
+    // Leftovers from before a previous stop belong to the old statistics
+    for (report_ring *ring = reporter.rings; ring != NULL; ring = ring->next) {
+        atomic_store(&ring->head, atomic_load(&ring->tail));
+        atomic_store(&ring->dropped, 0);
+    }
+    reporter.retired_dropped = 0;
+
+    if (!fscl_thread_create(&reporter.thread, report_run, NULL)) {
+        fscl_mutex_unlock(&reporter.lock);
+        return false;
+    }
+    atomic_store_explicit(&reporter.running, true, memory_order_release);
+    fscl_mutex_unlock(&reporter.lock);
+    return true;
+}
+
+void fscl_contract_report_stop(void) {
+    fscl_mutex_lock(&reporter.lock);
+    if (!atomic_load(&reporter.running) || reporter.stopping) {
+        fscl_mutex_unlock(&reporter.lock);
+        return;
+    }
+    atomic_store(&reporter.running, false);
+    reporter.stopping = true;
+    fscl_cond_broadcast(&reporter.wake);
+    fscl_mutex_unlock(&reporter.lock);
+
+    fscl_thread_join(reporter.thread);
+
+    fscl_mutex_lock(&reporter.lock);
+    report_drain_locked();
+    free(reporter.sites);
+    reporter.sites = NULL;
+    reporter.site_mask = 0;
+    reporter.site_count = 0;
+    reporter.stopping = false;
+    fscl_mutex_unlock(&reporter.lock);
+}
+
+void fscl_contract_report_flush(void) {
+    fscl_mutex_lock(&reporter.lock);
+    if (atomic_load(&reporter.running)) {
+        report_drain_locked();
+    }
+    // Batches another thread drained first must reach their callbacks too,
+    // unless that thread is the one calling
+    while (reporter.delivering > 0 && !report_in_callback) {
+        fscl_cond_wait(&reporter.delivered, &reporter.lock);
+    }
+    fscl_mutex_unlock(&reporter.lock);
+}
+
+ccontract_report_stats fscl_contract_report_stats(void) {
+    ccontract_report_stats stats;
+    fscl_mutex_lock(&reporter.lock);
+    stats.violations = reporter.violations;
+    stats.reported = reporter.reported;
+    stats.suppressed = reporter.suppressed;
+    stats.dropped = reporter.retired_dropped;
+    for (report_ring *ring = reporter.rings; ring != NULL; ring = ring->next) {
+        stats.dropped += atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+    }
+    stats.sites = reporter.site_count;
+    fscl_mutex_unlock(&reporter.lock);
+    return stats;
+}
+
+void fscl_contract_report_sink_callback(ccontract_report_fn report, void *context) {
+    fscl_mutex_lock(&reporter.lock);
+    reporter.sink = REPORT_SINK_CALLBACK;
+    reporter.callback = report;
+    reporter.context = context;
+    fscl_mutex_unlock(&reporter.lock);
+}
+
+void fscl_contract_report_sink_fd(int fd) {
+    fscl_mutex_lock(&reporter.lock);
+    reporter.sink = REPORT_SINK_FD;
+    reporter.fd = fd;
+    fscl_mutex_unlock(&reporter.lock);
+}
+
+void fscl_contract_report_sink_memory(char *buffer, size_t size) {
+    fscl_mutex_lock(&reporter.lock);
+    reporter.sink = REPORT_SINK_MEMORY;
+    reporter.memory = buffer;
+    reporter.memory_size = size;
+    reporter.memory_length = 0;
+    if (size > 0) {
+        buffer[0] = '\0';
+    }
+    fscl_mutex_unlock(&reporter.lock);
+}
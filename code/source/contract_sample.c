@@ -0,0 +1,407 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#define _POSIX_C_SOURCE 200809L
+#define _DARWIN_C_SOURCE
+#include "fossil/xpattern/contract_sample.h"
+#include "xthread.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define SAMPLE_HAVE_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define SAMPLE_HAVE_TSC 1
+#endif
+
+enum { SAMPLE_RUN, SAMPLE_SKIPPED, SAMPLE_EVALUATIONS, SAMPLE_FAILURES, SAMPLE_CYCLES, SAMPLE_COUNTERS };
+
+// Counters of one site in one thread. Only the owning thread writes them;
+// the relaxed atomics just let the statistics read them without a race.
+struct ccontract_slot {
+    unsigned countdown;
+    unsigned long long started;
+    atomic_ullong counts[SAMPLE_COUNTERS];
+};
+
+enum { SAMPLE_PAGE = 64 };
+
+// Per-thread slots indexed by site id. Slots live in fixed pages that never
+// move, so a check can hold its slot while its condition registers new sites.
+typedef struct sample_block {
+    struct sample_block *next;
+    ccontract_slot **pages;
+    size_t capacity;  // Slots covered by the pages
+} sample_block;
+
+typedef struct {
+    unsigned long long counts[SAMPLE_COUNTERS];
+} sample_totals;
+
+static struct {
+    fscl_mutex_t lock;
+    bool key_ready;
+    fscl_tls_t key;
+    size_t next_id;
+    sample_block *blocks;
+    ccontract_site **sites;  // Registered sites, by id
+    sample_totals *retired;  // Counts of exited threads, by id
+    size_t capacity;
+    atomic_uint global_period;
+} sampler = { .lock = FSCL_MUTEX_INITIALIZER, .next_id = 1 };
+
+static _Thread_local sample_block *local_block = NULL;
+
+static inline ccontract_slot *sample_at(sample_block *block, size_t id) {
+    return &block->pages[id / SAMPLE_PAGE][id % SAMPLE_PAGE];
+}
+
+static bool sample_grow_pages(sample_block *block, size_t id) {
+    size_t count = id / SAMPLE_PAGE + 1;
+    ccontract_slot **pages = realloc(block->pages, count * sizeof(ccontract_slot *));
+    if (pages == NULL) {
+        return false;
+    }
+    block->pages = pages;
+    for (size_t n = block->capacity / SAMPLE_PAGE; n < count; ++n) {
+        ccontract_slot *page = malloc(SAMPLE_PAGE * sizeof(ccontract_slot));
+        if (page == NULL) {
+            return false;
+        }
+        for (size_t i = 0; i < SAMPLE_PAGE; ++i) {
+            page[i].countdown = 1;
+            page[i].started = 0;
+            for (int c = 0; c < SAMPLE_COUNTERS; ++c) {
+                atomic_init(&page[i].counts[c], 0);
+            }
+        }
+        pages[n] = page;
+        block->capacity = (n + 1) * SAMPLE_PAGE;
+    }
+    return true;
+}
+
+// Fold the counters of an exiting thread into the retired totals
+static void sample_retire(void *value) {
+    sample_block *block = value;
+    fscl_mutex_lock(&sampler.lock);
+    for (sample_block **link = &sampler.blocks; *link != NULL; link = &(*link)->next) {
+        if (*link == block) {
+            *link = block->next;
+            break;
+        }
+    }
+    for (size_t id = 0; id < block->capacity && id < sampler.capacity; ++id) {
+        for (int c = 0; c < SAMPLE_COUNTERS; ++c) {
+            sampler.retired[id].counts[c] += atomic_load(&sample_at(block, id)->counts[c]);
+        }
+    }
+    fscl_mutex_unlock(&sampler.lock);
+    for (size_t n = 0; n < block->capacity / SAMPLE_PAGE; ++n) {
+        free(block->pages[n]);
+    }
+    free(block->pages);
+    free(block);
+}
+
+static size_t sample_round_up(size_t needed) {
+    size_t capacity = 16;
+    while (capacity <= needed) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+static bool sample_grow_sites(size_t id) {
+    size_t capacity = sample_round_up(id);
+    sample_totals *retired = realloc(sampler.retired, capacity * sizeof(sample_totals));
+    if (retired == NULL) {
+        return false;
+    }
+    sampler.retired = retired;
+    ccontract_site **sites = realloc(sampler.sites, capacity * sizeof(ccontract_site *));
+    if (sites == NULL) {
+        return false;
+    }
+    sampler.sites = sites;
+    memset(retired + sampler.capacity, 0, (capacity - sampler.capacity) * sizeof(sample_totals));
+    memset(sites + sampler.capacity, 0, (capacity - sampler.capacity) * sizeof(ccontract_site *));
+    sampler.capacity = capacity;
+    return true;
+}
+
+// First use of a site, or of any site on this thread
+static bool sample_prepare(ccontract_site *site) {
+    bool ready = false;
+    fscl_mutex_lock(&sampler.lock);
+
+    size_t id = __atomic_load_n(&site->id, __ATOMIC_ACQUIRE);
+    if (id == 0) {
+        id = sampler.next_id;
+        if (id >= sampler.capacity && !sample_grow_sites(id)) {
+            goto done;
+        }
+        sampler.sites[id] = site;
+        sampler.next_id++;
+        __atomic_store_n(&site->id, id, __ATOMIC_RELEASE);
+    }
+
+    if (!sampler.key_ready && !(sampler.key_ready = fscl_tls_create(&sampler.key, sample_retire))) {
+        goto done;
+    }
+    if (local_block == NULL) {
+        sample_block *block = calloc(1, sizeof(sample_block));
+        if (block == NULL) {
+            goto done;
+        }
+        block->next = sampler.blocks;
+        sampler.blocks = block;
+        local_block = block;
+        fscl_tls_set(sampler.key, block);
+    }
+    if (id >= local_block->capacity && !sample_grow_pages(local_block, id)) {
+        goto done;
+    }
+    ready = true;
+
+done:
+    fscl_mutex_unlock(&sampler.lock);
+    return ready;
+}
+
+ccontract_slot *fscl_contract_slot(ccontract_site *site) {
+    size_t id = __atomic_load_n(&site->id, __ATOMIC_ACQUIRE);
+    sample_block *block = local_block;
+    if (id == 0 || block == NULL || id >= block->capacity) {
+        if (!sample_prepare(site)) {
+            return NULL;
+        }
+        id = __atomic_load_n(&site->id, __ATOMIC_ACQUIRE);
+        block = local_block;
+    }
+    return sample_at(block, id);
+}
+
+static inline void sample_bump(atomic_ullong *counter) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+bool fscl_contract_sample(ccontract_site *site) {
+    return fscl_contract_slot_sample(fscl_contract_slot(site), site);
+}
+
+bool fscl_contract_slot_sample(ccontract_slot *slot, ccontract_site *site) {
+    if (slot == NULL) {
+        return true;
+    }
+
+    if (slot->countdown > 1) {
+        slot->countdown--;
+        sample_bump(&slot->counts[SAMPLE_SKIPPED]);
+        return false;
+    }
+
+    unsigned period = atomic_load_explicit(&sampler.global_period, memory_order_relaxed);
+    if (period == 0) {
+        period = __atomic_load_n(&site->period, __ATOMIC_RELAXED);
+        if (period == 0) {
+            sample_bump(&slot->counts[SAMPLE_SKIPPED]);
+            return false;
+        }
+    }
+    slot->countdown = period;
+    sample_bump(&slot->counts[SAMPLE_RUN]);
+    return true;
+}
+
+void fscl_contract_sample_set_rate(ccontract_site *site, unsigned period) {
+    __atomic_store_n(&site->period, period, __ATOMIC_RELAXED);
+}
+
+void fscl_contract_sample_set_global_rate(unsigned period) {
+    atomic_store_explicit(&sampler.global_period, period, memory_order_relaxed);
+}
+
+static void sample_add(sample_totals *totals, size_t id) {
+    for (int c = 0; c < SAMPLE_COUNTERS; ++c) {
+        totals->counts[c] += sampler.retired[id].counts[c];
+    }
+    for (sample_block *block = sampler.blocks; block != NULL; block = block->next) {
+        if (id < block->capacity) {
+            for (int c = 0; c < SAMPLE_COUNTERS; ++c) {
+                totals->counts[c] += atomic_load_explicit(&sample_at(block, id)->counts[c], memory_order_relaxed);
+            }
+        }
+    }
+}
+
+ccontract_sample_stats fscl_contract_sample_stats(ccontract_site *site) {
+    sample_totals totals = { { 0 } };
+    fscl_mutex_lock(&sampler.lock);
+    size_t id = __atomic_load_n(&site->id, __ATOMIC_ACQUIRE);
+    if (id != 0) {
+        sample_add(&totals, id);
+    }
+    fscl_mutex_unlock(&sampler.lock);
+    return (ccontract_sample_stats){ totals.counts[SAMPLE_RUN], totals.counts[SAMPLE_SKIPPED] };
+}
+
+ccontract_sample_stats fscl_contract_sample_totals(void) {
+    sample_totals totals = { { 0 } };
+    fscl_mutex_lock(&sampler.lock);
+    for (size_t id = 1; id < sampler.next_id; ++id) {
+        sample_add(&totals, id);
+    }
+    fscl_mutex_unlock(&sampler.lock);
+    return (ccontract_sample_stats){ totals.counts[SAMPLE_RUN], totals.counts[SAMPLE_SKIPPED] };
+}
+
+bool fscl_contract_require_string_length_sampled(ccontract_site *site, const char *str, size_t min_length,
+                                                 size_t max_length, const char *param_name) {
+    return !fscl_contract_sample(site) || fscl_contract_require_string_length(str, min_length, max_length, param_name);
+}
+
+bool fscl_contract_require_custom_condition_sampled(ccontract_site *site, bool (*custom_condition)(),
+                                                    const char *param_name) {
+    return !fscl_contract_sample(site) || fscl_contract_require_custom_condition(custom_condition, param_name);
+}
+
+// =================================================================
+// Profiling
+// =================================================================
+
+static inline unsigned long long sample_clock(void) {
+#if defined(SAMPLE_HAVE_TSC)
+    return (unsigned long long)__rdtsc();
+#else
+    return fscl_time_ns();
+#endif
+}
+
+static void profile_count(ccontract_slot *slot, bool held, unsigned long long stopped) {
+    sample_bump(&slot->counts[SAMPLE_EVALUATIONS]);
+    if (!held) {
+        sample_bump(&slot->counts[SAMPLE_FAILURES]);
+    }
+    unsigned long long cycles = atomic_load_explicit(&slot->counts[SAMPLE_CYCLES], memory_order_relaxed);
+    atomic_store_explicit(&slot->counts[SAMPLE_CYCLES], cycles + (stopped - slot->started), memory_order_relaxed);
+}
+
+void fscl_contract_profile_begin(ccontract_site *site) {
+    fscl_contract_slot_begin(fscl_contract_slot(site));
+}
+
+bool fscl_contract_profile_end(ccontract_site *site, bool held) {
+    unsigned long long stopped = sample_clock();
+    ccontract_slot *slot = fscl_contract_slot(site);
+    if (slot != NULL) {
+        profile_count(slot, held, stopped);
+    }
+    return held;
+}
+
+void fscl_contract_slot_begin(ccontract_slot *slot) {
+    if (slot != NULL) {
+        slot->started = sample_clock();
+    }
+}
+
+bool fscl_contract_slot_end(ccontract_slot *slot, bool held) {
+    if (slot != NULL) {
+        profile_count(slot, held, sample_clock());
+    }
+    return held;
+}
+
+static int profile_compare(const void *a, const void *b) {
+    const ccontract_profile_entry *left = a;
+    const ccontract_profile_entry *right = b;
+    if (left->cycles != right->cycles) {
+        return left->cycles < right->cycles ? 1 : -1;
+    }
+    return left->evaluations < right->evaluations ? 1 : (left->evaluations > right->evaluations ? -1 : 0);
+}
+
+// Collect every site sorted by time spent; caller holds the lock
+static ccontract_profile_entry *profile_collect(size_t *count) {
+    *count = sampler.next_id - 1;
+    ccontract_profile_entry *entries = malloc((*count ? *count : 1) * sizeof(ccontract_profile_entry));
+    if (entries == NULL) {
+        *count = 0;
+        return NULL;
+    }
+    for (size_t id = 1; id < sampler.next_id; ++id) {
+        sample_totals totals = { { 0 } };
+        sample_add(&totals, id);
+        const ccontract_site *site = sampler.sites[id];
+        entries[id - 1] = (ccontract_profile_entry){
+            site->name, site->file, site->line,
+            totals.counts[SAMPLE_EVALUATIONS], totals.counts[SAMPLE_FAILURES], totals.counts[SAMPLE_CYCLES],
+            totals.counts[SAMPLE_RUN], totals.counts[SAMPLE_SKIPPED]
+        };
+    }
+    qsort(entries, *count, sizeof(ccontract_profile_entry), profile_compare);
+    return entries;
+}
+
+size_t fscl_contract_profile_snapshot(ccontract_profile_entry *entries, size_t capacity) {
+    size_t count;
+    fscl_mutex_lock(&sampler.lock);
+    ccontract_profile_entry *sorted = profile_collect(&count);
+    fscl_mutex_unlock(&sampler.lock);
+
+    if (sorted != NULL && entries != NULL) {
+        memcpy(entries, sorted, (count < capacity ? count : capacity) * sizeof(ccontract_profile_entry));
+    }
+    free(sorted);
+    return count;
+}
+
+void fscl_contract_profile_report(FILE *stream) {
+    size_t count;
+    fscl_mutex_lock(&sampler.lock);
+    ccontract_profile_entry *sorted = profile_collect(&count);
+    fscl_mutex_unlock(&sampler.lock);
+    if (sorted == NULL) {
+        return;
+    }
+
+    fprintf(stream, "%16s %12s %10s %12s %12s  %s\n", "cycles", "evaluations", "failures", "cycles/eval", "skipped",
+            "site");
+    for (size_t i = 0; i < count; ++i) {
+        const ccontract_profile_entry *entry = &sorted[i];
+        unsigned long long per_eval = entry->evaluations ? entry->cycles / entry->evaluations : 0;
+        fprintf(stream, "%16llu %12llu %10llu %12llu %12llu  %s (%s:%d)\n", entry->cycles, entry->evaluations,
+                entry->failures, per_eval, entry->skipped, entry->name != NULL ? entry->name : "?",
+                entry->file != NULL ? entry->file : "?", entry->line);
+    }
+    free(sorted);
+}
+
+void fscl_contract_profile_reset(void) {
+    fscl_mutex_lock(&sampler.lock);
+    if (sampler.retired != NULL) {
+        memset(sampler.retired, 0, sampler.capacity * sizeof(sample_totals));
+    }
+    for (sample_block *block = sampler.blocks; block != NULL; block = block->next) {
+        for (size_t id = 0; id < block->capacity; ++id) {
+            for (int c = 0; c < SAMPLE_COUNTERS; ++c) {
+                atomic_store_explicit(&sample_at(block, id)->counts[c], 0, memory_order_relaxed);
+            }
+        }
+    }
+    fscl_mutex_unlock(&sampler.lock);
+}
@@ -0,0 +1,146 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#define _POSIX_C_SOURCE 200809L
+#define _DARWIN_C_SOURCE
+#include "fossil/xpattern/contract_set.h"
+#include "xthread.h"
+
+#define SET_TIMING_PERIOD 16 // Time one adaptive check in this many
+
+void fscl_contract_set_init(ccontract_set *set, ccontract_rule *storage, size_t capacity) {
+    set->rules = storage;
+    set->count = 0;
+    set->capacity = capacity;
+    set->reorder_interval = 0;
+    set->checks = 0;
+}
+
+bool fscl_contract_set_add(ccontract_set *set, ccontract_predicate check, const char *name) {
+    if (set->count == set->capacity || check == NULL) {
+        return false;
+    }
+    set->rules[set->count++] = (ccontract_rule){ check, name, 0, 0, 0, 0, 0.0 };
+    return true;
+}
+
+void fscl_contract_set_adaptive(ccontract_set *set, unsigned reorder_interval) {
+    set->reorder_interval = reorder_interval;
+    set->checks = 0;
+}
+
+// Fixed order: a pure read of the set
+static const ccontract_rule *set_check_fixed(const ccontract_set *set, const void *context) {
+    for (size_t i = 0; i < set->count; ++i) {
+        if (FSCL_UNLIKELY(!set->rules[i].check(context))) {
+            return &set->rules[i];
+        }
+    }
+    return NULL;
+}
+
+static const ccontract_rule *set_check_adaptive(ccontract_set *set, const void *context) {
+    bool timed = set->checks % SET_TIMING_PERIOD == 0;
+    const ccontract_rule *failed = NULL;
+
+    for (size_t i = 0; i < set->count; ++i) {
+        ccontract_rule *rule = &set->rules[i];
+        bool held;
+        if (timed) {
+            unsigned long long started = fscl_time_ns();
+            held = rule->check(context);
+            rule->cost_ns += fscl_time_ns() - started;
+            rule->timed++;
+        } else {
+            held = rule->check(context);
+        }
+        rule->evaluations++;
+        if (FSCL_UNLIKELY(!held)) {
+            rule->failures++;
+            failed = rule;
+            break;
+        }
+    }
+
+    if (++set->checks >= set->reorder_interval) {
+        // Reordering moves rules around, so report the failure by position
+        ccontract_predicate check = failed != NULL ? failed->check : NULL;
+        fscl_contract_set_reorder(set);
+        for (size_t i = 0; check != NULL && i < set->count; ++i) {
+            if (set->rules[i].check == check) {
+                return &set->rules[i];
+            }
+        }
+    }
+    return failed;
+}
+
+const ccontract_rule *fscl_contract_set_check(ccontract_set *set, const void *context) {
+    if (set->reorder_interval == 0) {
+        return set_check_fixed(set, context);
+    }
+    return set_check_adaptive(set, context);
+}
+
+bool fscl_contract_set_require(ccontract_set *set, const void *context) {
+    const ccontract_rule *failed = fscl_contract_set_check(set, context);
+    if (failed != NULL) {
+        return fscl_contract_assert(false, failed->name != NULL ? failed->name : "contract set");
+    }
+    return true;
+}
+
+// For a short-circuit AND the expected cost is lowest when rules run in
+// decreasing order of failure probability per unit of cost
+void fscl_contract_set_reorder(ccontract_set *set) {
+    // Rules that were never timed are assumed to cost the average
+    double known_cost = 0.0;
+    size_t known = 0;
+    for (size_t i = 0; i < set->count; ++i) {
+        if (set->rules[i].timed > 0) {
+            known_cost += (double)set->rules[i].cost_ns / (double)set->rules[i].timed;
+            known++;
+        }
+    }
+    double average_cost = known > 0 ? known_cost / (double)known : 0.0;
+
+    for (size_t i = 0; i < set->count; ++i) {
+        ccontract_rule *rule = &set->rules[i];
+        double fail_rate = (double)(rule->failures + 1) / (double)(rule->evaluations + 2);
+        double cost = rule->timed > 0 ? (double)rule->cost_ns / (double)rule->timed : average_cost;
+        rule->rank = fail_rate / (cost + 1.0);
+    }
+
+    // Stable insertion sort; sets are small and usually nearly sorted
+    for (size_t i = 1; i < set->count; ++i) {
+        ccontract_rule rule = set->rules[i];
+        size_t j = i;
+        while (j > 0 && set->rules[j - 1].rank < rule.rank) {
+            set->rules[j] = set->rules[j - 1];
+            j--;
+        }
+        set->rules[j] = rule;
+    }
+
+    // Halve the history so the order follows changes in the workload,
+    // keeping at least one timing sample per rule that has one
+    for (size_t i = 0; i < set->count; ++i) {
+        ccontract_rule *rule = &set->rules[i];
+        rule->evaluations /= 2;
+        rule->failures /= 2;
+        if (rule->timed > 1) {
+            rule->timed /= 2;
+            rule->cost_ns /= 2;
+        }
+    }
+    set->checks = 0;
+}
@@ -0,0 +1,339 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/contract_span.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SPAN_BLOCK 32 // Elements checked between early-exit tests
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SPAN_HAVE_X86 1
+#define SPAN_HAVE_AVX2 1
+#define SPAN_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_M_X64)
+#include <emmintrin.h>
+#define SPAN_HAVE_X86 1
+#define SPAN_TARGET(isa)
+#endif
+
+#if UINTPTR_MAX == 0xFFFFFFFFFFFFFFFFu
+#define SPAN_HAVE_POINTER_64 1
+#endif
+
+enum { SPAN_SCALAR, SPAN_SSE2, SPAN_AVX2 };
+
+static int span_detect(void) {
+#if defined(SPAN_HAVE_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SPAN_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SPAN_SSE2;
+    }
+#elif defined(SPAN_HAVE_X86)
+    return SPAN_SSE2;
+#endif
+    return SPAN_SCALAR;
+}
+
+static int span_level(void) {
+    static atomic_int cached = -1;
+    int level = atomic_load_explicit(&cached, memory_order_relaxed);
+    if (level < 0) {
+        level = span_detect();
+        atomic_store_explicit(&cached, level, memory_order_relaxed);
+    }
+    return level;
+}
+
+// =================================================================
+// Portable kernels
+// =================================================================
+
+// Exact index of the first failure at or after `start`
+static size_t int_outside_tail(const int *values, size_t start, size_t count, int min, int max) {
+    for (size_t i = start; i < count; ++i) {
+        if (values[i] < min || values[i] > max) {
+            return i;
+        }
+    }
+    return count;
+}
+
+static size_t double_outside_tail(const double *values, size_t start, size_t count, double min, double max) {
+    for (size_t i = start; i < count; ++i) {
+        if (!(values[i] >= min && values[i] <= max)) {
+            return i;
+        }
+    }
+    return count;
+}
+
+static size_t null_tail(const void *const *pointers, size_t start, size_t count) {
+    for (size_t i = start; i < count; ++i) {
+        if (pointers[i] == NULL) {
+            return i;
+        }
+    }
+    return count;
+}
+
+// Branch-free blocks the compiler can vectorize on any target
+static size_t int_outside_scalar(const int *values, size_t count, int min, int max) {
+    size_t i = 0;
+    for (; i + SPAN_BLOCK <= count; i += SPAN_BLOCK) {
+        int bad = 0;
+        for (size_t j = 0; j < SPAN_BLOCK; ++j) {
+            bad |= (values[i + j] < min) | (values[i + j] > max);
+        }
+        if (bad) {
+            break;
+        }
+    }
+    return int_outside_tail(values, i, count, min, max);
+}
+
+static size_t double_outside_scalar(const double *values, size_t count, double min, double max) {
+    size_t i = 0;
+    for (; i + SPAN_BLOCK <= count; i += SPAN_BLOCK) {
+        int bad = 0;
+        for (size_t j = 0; j < SPAN_BLOCK; ++j) {
+            bad |= !(values[i + j] >= min) | !(values[i + j] <= max);
+        }
+        if (bad) {
+            break;
+        }
+    }
+    return double_outside_tail(values, i, count, min, max);
+}
+
+static size_t null_scalar(const void *const *pointers, size_t count) {
+    size_t i = 0;
+    for (; i + SPAN_BLOCK <= count; i += SPAN_BLOCK) {
+        int bad = 0;
+        for (size_t j = 0; j < SPAN_BLOCK; ++j) {
+            bad |= pointers[i + j] == NULL;
+        }
+        if (bad) {
+            break;
+        }
+    }
+    return null_tail(pointers, i, count);
+}
+
+// =================================================================
+// x86 kernels
+// =================================================================
+
+#if defined(SPAN_HAVE_X86)
+SPAN_TARGET("sse2") static size_t int_outside_sse2(const int *values, size_t count, int min, int max) {
+    const __m128i low = _mm_set1_epi32(min);
+    const __m128i high = _mm_set1_epi32(max);
+    size_t i = 0;
+    for (; i + SPAN_BLOCK <= count; i += SPAN_BLOCK) {
+        __m128i bad = _mm_setzero_si128();
+        for (size_t j = 0; j < SPAN_BLOCK; j += 4) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(values + i + j));
+            bad = _mm_or_si128(bad, _mm_or_si128(_mm_cmpgt_epi32(low, x), _mm_cmpgt_epi32(x, high)));
+        }
+        if (_mm_movemask_epi8(bad) != 0) {
+            break;
+        }
+    }
+    return int_outside_tail(values, i, count, min, max);
+}
+
+SPAN_TARGET("sse2") static size_t double_outside_sse2(const double *values, size_t count, double min, double max) {
+    const __m128d low = _mm_set1_pd(min);
+    const __m128d high = _mm_set1_pd(max);
+    size_t i = 0;
+    for (; i + SPAN_BLOCK <= count; i += SPAN_BLOCK) {
+        __m128d bad = _mm_setzero_pd();
+        for (size_t j = 0; j < SPAN_BLOCK; j += 2) {
+            __m128d x = _mm_loadu_pd(values + i + j);
+            // The "not" comparisons are also true for NaN
+            bad = _mm_or_pd(bad, _mm_or_pd(_mm_cmpnge_pd(x, low), _mm_cmpnle_pd(x, high)));
+        }
+        if (_mm_movemask_pd(bad) != 0) {
+            break;
+        }
+    }
+    return double_outside_tail(values, i, count, min, max);
+}
+
+#if defined(SPAN_HAVE_POINTER_64)
+SPAN_TARGET("sse2") static size_t null_sse2(const void *const *pointers, size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + SPAN_BLOCK <= count; i += SPAN_BLOCK) {
+        int bad = 0;
+        for (size_t j = 0; j < SPAN_BLOCK; j += 2) {
+            // SSE2 has no 64-bit compare: a lane is null when all 8 bytes are
+            int zeros = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(pointers + i + j)), zero));
+            bad |= (zeros & 0xFF) == 0xFF || (zeros >> 8) == 0xFF;
+        }
+        if (bad) {
+            break;
+        }
+    }
+    return null_tail(pointers, i, count);
+}
+#endif
+#endif
+
+#if defined(SPAN_HAVE_AVX2)
+SPAN_TARGET("avx2") static size_t int_outside_avx2(const int *values, size_t count, int min, int max) {
+    const __m256i low = _mm256_set1_epi32(min);
+    const __m256i high = _mm256_set1_epi32(max);
+    size_t i = 0;
+    for (; i + SPAN_BLOCK <= count; i += SPAN_BLOCK) {
+        __m256i bad = _mm256_setzero_si256();
+        for (size_t j = 0; j < SPAN_BLOCK; j += 8) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(values + i + j));
+            bad = _mm256_or_si256(bad, _mm256_or_si256(_mm256_cmpgt_epi32(low, x), _mm256_cmpgt_epi32(x, high)));
+        }
+        if (!_mm256_testz_si256(bad, bad)) {
+            break;
+        }
+    }
+    return int_outside_tail(values, i, count, min, max);
+}
+
+SPAN_TARGET("avx2") static size_t double_outside_avx2(const double *values, size_t count, double min, double max) {
+    const __m256d low = _mm256_set1_pd(min);
+    const __m256d high = _mm256_set1_pd(max);
+    size_t i = 0;
+    for (; i + SPAN_BLOCK <= count; i += SPAN_BLOCK) {
+        __m256d bad = _mm256_setzero_pd();
+        for (size_t j = 0; j < SPAN_BLOCK; j += 4) {
+            __m256d x = _mm256_loadu_pd(values + i + j);
+            bad = _mm256_or_pd(bad, _mm256_or_pd(_mm256_cmp_pd(x, low, _CMP_NGE_UQ), _mm256_cmp_pd(x, high, _CMP_NLE_UQ)));
+        }
+        if (_mm256_movemask_pd(bad) != 0) {
+            break;
+        }
+    }
+    return double_outside_tail(values, i, count, min, max);
+}
+
+#if defined(SPAN_HAVE_POINTER_64)
+SPAN_TARGET("avx2") static size_t null_avx2(const void *const *pointers, size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + SPAN_BLOCK <= count; i += SPAN_BLOCK) {
+        __m256i bad = _mm256_setzero_si256();
+        for (size_t j = 0; j < SPAN_BLOCK; j += 4) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(pointers + i + j));
+            bad = _mm256_or_si256(bad, _mm256_cmpeq_epi64(x, zero));
+        }
+        if (!_mm256_testz_si256(bad, bad)) {
+            break;
+        }
+    }
+    return null_tail(pointers, i, count);
+}
+#endif
+#endif
+
+// =================================================================
+// Public API
+// =================================================================
+
+size_t fscl_contract_find_outside_range(const int *values, size_t count, int min, int max) {
+    switch (span_level()) {
+#if defined(SPAN_HAVE_AVX2)
+        case SPAN_AVX2:
+            return int_outside_avx2(values, count, min, max);
+#endif
+#if defined(SPAN_HAVE_X86)
+        case SPAN_SSE2:
+            return int_outside_sse2(values, count, min, max);
+#endif
+        default:
+            return int_outside_scalar(values, count, min, max);
+    }
+}
+
+size_t fscl_contract_find_outside_double_range(const double *values, size_t count, double min, double max) {
+    switch (span_level()) {
+#if defined(SPAN_HAVE_AVX2)
+        case SPAN_AVX2:
+            return double_outside_avx2(values, count, min, max);
+#endif
+#if defined(SPAN_HAVE_X86)
+        case SPAN_SSE2:
+            return double_outside_sse2(values, count, min, max);
+#endif
+        default:
+            return double_outside_scalar(values, count, min, max);
+    }
+}
+
+size_t fscl_contract_find_null(const void *const *pointers, size_t count) {
+    switch (span_level()) {
+#if defined(SPAN_HAVE_AVX2) && defined(SPAN_HAVE_POINTER_64)
+        case SPAN_AVX2:
+            return null_avx2(pointers, count);
+#endif
+#if defined(SPAN_HAVE_X86) && defined(SPAN_HAVE_POINTER_64)
+        case SPAN_SSE2:
+            return null_sse2(pointers, count);
+#endif
+        default:
+            return null_scalar(pointers, count);
+    }
+}
+
+ccontract_span fscl_contract_span(const void *data, size_t length, size_t element_size) {
+    ccontract_span span = { data, length, element_size };
+    return span;
+}
+
+bool fscl_contract_require_span_length(ccontract_span span, size_t expected_length, size_t element_size,
+                                       const char *param_name) {
+    bool valid = (span.data != NULL || span.length == 0) && span.length == expected_length &&
+                 span.element_size == element_size;
+    return fscl_contract_assert(valid, param_name);
+}
+
+bool fscl_contract_require_all_within_range(const int *values, size_t count, int min, int max, const char *param_name) {
+    bool valid = (values != NULL || count == 0) && fscl_contract_find_outside_range(values, count, min, max) == count;
+    return fscl_contract_assert(valid, param_name);
+}
+
+bool fscl_contract_require_all_within_double_range(const double *values, size_t count, double min, double max,
+                                                   const char *param_name) {
+    bool valid = (values != NULL || count == 0) &&
+                 fscl_contract_find_outside_double_range(values, count, min, max) == count;
+    return fscl_contract_assert(valid, param_name);
+}
+
+bool fscl_contract_require_all_not_null(const void *const *pointers, size_t count, const char *param_name) {
+    bool valid = (pointers != NULL || count == 0) && fscl_contract_find_null(pointers, count) == count;
+    return fscl_contract_assert(valid, param_name);
+}
+
+bool fscl_contract_require_string_length_bounded(const char *str, size_t min_length, size_t max_length,
+                                                 const char *param_name) {
+    size_t length = 0;
+    if (str != NULL) {
+        // memchr stops at the first match, so nothing past the terminator
+        // or past max_length + 1 bytes is read; libc scans it with SIMD
+        const char *end = max_length < SIZE_MAX ? memchr(str, '\0', max_length + 1) : str + strlen(str);
+        length = end != NULL ? (size_t)(end - str) : max_length + 1;
+    }
+    return fscl_contract_assert(length >= min_length && length <= max_length, param_name);
+}
@@ -10,23 +10,139 @@ Description:
     feel free to contact Michael at michaelbrockus@gmail.com.
 ==============================================================================
 */
+#define _POSIX_C_SOURCE 200809L
+#ifndef FSCL_XPATTERN_INLINE
+#define FSCL_XPATTERN_INLINE
+#endif
 #include "fossil/xpattern/lazy.h"
+#include "fossil/xpattern/lazy_future.h"
+#include "xtrace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Thunk for CLAZY_FILE: map the whole file read-only without touching pages
+static void lazy_map_file(clazy *lazy, void *context) {
+    const char *path = context;
+    clazy_view view = { NULL, 0 };
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            size.QuadPart = -1;
+        }
+        if (size.QuadPart == 0) {
+            view.data = "";
+        } else if (size.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping != NULL) {
+                view.data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                view.length = view.data != NULL ? (size_t)size.QuadPart : 0;
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            info.st_size = -1;
+        }
+        if (info.st_size == 0) {
+            view.data = "";
+        } else if (info.st_size > 0) {
+            void *address = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED) {
+                view.data = address;
+                view.length = (size_t)info.st_size;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    lazy->data.view_value = view;
+    lazy->cache.memoized_view = view;
+}
+
+static void lazy_unmap_file(clazy_view view) {
+    if (view.data == NULL || view.length == 0) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(view.data);
+#else
+    munmap((void *)view.data, view.length);
+#endif
+}
+
+// External definitions of the inline fast paths in lazy.h
+extern inline int fscl_lazy_force_int(clazy *lazy);
+extern inline bool fscl_lazy_force_bool(clazy *lazy);
+extern inline char fscl_lazy_force_char(clazy *lazy);
+extern inline const char *fscl_lazy_force_string(clazy *lazy);
+extern inline int64_t fscl_lazy_force_int64(clazy *lazy);
+extern inline uint64_t fscl_lazy_force_uint64(clazy *lazy);
+extern inline double fscl_lazy_force_double(clazy *lazy);
+extern inline void *fscl_lazy_force_pointer(clazy *lazy);
+extern inline clazy_bytes fscl_lazy_force_bytes(clazy *lazy);
+extern inline void fscl_lazy_set_int(clazy *lazy, int value);
+extern inline void fscl_lazy_set_bool(clazy *lazy, bool value);
+extern inline void fscl_lazy_set_letter(clazy *lazy, char value);
+extern inline void fscl_lazy_set_int64(clazy *lazy, int64_t value);
+extern inline void fscl_lazy_set_uint64(clazy *lazy, uint64_t value);
+extern inline void fscl_lazy_set_double(clazy *lazy, double value);
+extern inline void fscl_lazy_set_pointer(clazy *lazy, void *value);
+
 // Function to create a lazy type
 clazy fscl_lazy_create(clazy_type type) {
+    return fscl_lazy_create_thunk(type, NULL, NULL);
+}
+
+// Function to create a lazy type backed by a deferred constructor
+clazy fscl_lazy_create_thunk(clazy_type type, clazy_thunk thunk, void *context) {
     clazy lazy;
     lazy.is_evaluated = 0;
     lazy.type = type;
+    lazy.thunk = thunk;
+    lazy.context = context;
+    lazy.future = NULL;
+    lazy.allocator = fscl_alloc_default();
     return lazy;
 }
 
+// Function to create a lazy type backed by a memory-mapped file
+clazy fscl_lazy_create_file(const char *path) {
+    return fscl_lazy_create_thunk(CLAZY_FILE, lazy_map_file, (void *)path);
+}
+
+// Function to switch the allocator of a lazy type
+void fscl_lazy_set_allocator(clazy *lazy, const callocator *allocator) {
+    fscl_lazy_erase(lazy);
+    lazy->allocator = allocator;
+}
+
 // Function to force the evaluation of the lazy type
 void fscl_lazy_force(clazy *lazy) {
+    if (lazy->future != NULL) {
+        fscl_lazy_await(lazy);
+    }
     if (!lazy->is_evaluated) {
+        FSCL_TRACE_LAZY_FORCE_BEGIN(lazy);
         switch (lazy->type) {
             case CLAZY_INT:
                 lazy->data.int_value = 0;  // Default value for int
@@ -44,6 +160,30 @@ void fscl_lazy_force(clazy *lazy) {
                 lazy->data.string_value.data = NULL;  // Default value for string
                 lazy->cache.memoized_string = lazy->data.string_value;
                 break;
+            case CLAZY_FILE:
+                lazy->data.view_value = (clazy_view){ NULL, 0 };  // Default value for file
+                lazy->cache.memoized_view = lazy->data.view_value;
+                break;
+            case CLAZY_INT64:
+                lazy->data.int64_value = 0;  // Default value for int64
+                lazy->cache.memoized_int64 = lazy->data.int64_value;
+                break;
+            case CLAZY_UINT64:
+                lazy->data.uint64_value = 0;  // Default value for uint64
+                lazy->cache.memoized_uint64 = lazy->data.uint64_value;
+                break;
+            case CLAZY_DOUBLE:
+                lazy->data.double_value = 0.0;  // Default value for double
+                lazy->cache.memoized_double = lazy->data.double_value;
+                break;
+            case CLAZY_POINTER:
+                lazy->data.pointer_value = NULL;  // Default value for pointer
+                lazy->cache.memoized_pointer = lazy->data.pointer_value;
+                break;
+            case CLAZY_BYTES:
+                lazy->data.bytes_value = (clazy_bytes){ NULL, 0 };  // Default value for bytes
+                lazy->cache.memoized_bytes = lazy->data.bytes_value;
+                break;
             case CLAZY_NULL:
                 // No evaluation needed for null type
                 break;
@@ -51,37 +191,47 @@ void fscl_lazy_force(clazy *lazy) {
                 // Handle unknown type
                 break;
         }
+        if (lazy->thunk != NULL) {
+            lazy->thunk(lazy, lazy->context);
+        }
         lazy->is_evaluated = 1;
+        FSCL_TRACE_LAZY_FORCE_END(lazy);
     }
 }
 
-// Function to retrieve the value or default value if not evaluated
-int fscl_lazy_force_int(clazy *lazy) {
-    fscl_lazy_force(lazy);
-    return lazy->cache.memoized_int;
-}
-
-bool fscl_lazy_force_bool(clazy *lazy) {
-    fscl_lazy_force(lazy);
-    return lazy->cache.memoized_bool;
-}
-
-char fscl_lazy_force_char(clazy *lazy) {
+clazy_view fscl_lazy_force_view(clazy *lazy) {
     fscl_lazy_force(lazy);
-    return lazy->cache.memoized_char;
-}
-
-const char* fscl_lazy_force_string(clazy *lazy) {
-    fscl_lazy_force(lazy);
-    return lazy->cache.memoized_string.data;
+    if (lazy->type == CLAZY_STRING) {
+        const char *data = lazy->cache.memoized_string.data;
+        return (clazy_view){ data, data != NULL ? strlen(data) : 0 };
+    }
+    if (lazy->type == CLAZY_FILE) {
+        return lazy->cache.memoized_view;
+    }
+    if (lazy->type == CLAZY_BYTES) {
+        return (clazy_view){ (const char *)lazy->cache.memoized_bytes.data, lazy->cache.memoized_bytes.length };
+    }
+    return (clazy_view){ NULL, 0 };
 }
 
 // Function to destroy the resources associated with a lazy string value
 void fscl_lazy_erase(clazy *lazy) {
+    if (lazy->future != NULL) {
+        fscl_lazy_await(lazy);
+    }
     if (lazy->is_evaluated) {
         switch (lazy->type) {
             case CLAZY_STRING:
-                free(lazy->cache.memoized_string.data);
+                if (lazy->cache.memoized_string.data != NULL) {
+                    fscl_free(lazy->allocator, lazy->cache.memoized_string.data,
+                              strlen(lazy->cache.memoized_string.data) + 1);
+                }
+                break;
+            case CLAZY_FILE:
+                lazy_unmap_file(lazy->cache.memoized_view);
+                break;
+            case CLAZY_BYTES:
+                fscl_free(lazy->allocator, lazy->cache.memoized_bytes.data, lazy->cache.memoized_bytes.length);
                 break;
             default:
                 // No resources to free for other types
@@ -93,10 +243,7 @@ void fscl_lazy_erase(clazy *lazy) {
 
 // Function to create a lazy sequence of integers
 clazy fscl_lazy_sequence() {
-    clazy lazy;
-    lazy.is_evaluated = 0;
-    lazy.type = CLAZY_INT;
-    return lazy;
+    return fscl_lazy_create(CLAZY_INT);
 }
 
 // Function to force the evaluation of the lazy sequence
@@ -109,10 +256,22 @@ int fscl_lazy_sequence_force(clazy *lazy, int n) {
     return lazy->cache.memoized_int;
 }
 
-// Utility function to set the value of a lazy integer
-void fscl_lazy_set_int(clazy *lazy, int value) {
-    lazy->is_evaluated = 1;
-    lazy->data.int_value = value;
+// Function to create a lazy stream backed by a generator
+clazy_stream fscl_lazy_stream_create(clazy_type type, clazy_generator generate, void *context, size_t length) {
+    clazy_stream stream;
+    stream.type = type;
+    stream.generate = generate;
+    stream.context = context;
+    stream.length = length;
+    return stream;
+}
+
+// Function to produce a single element of a lazy stream
+clazy fscl_lazy_stream_force(const clazy_stream *stream, size_t index) {
+    clazy item = fscl_lazy_create(stream->type);
+    stream->generate(&item, index, stream->context);
+    fscl_lazy_force(&item);
+    return item;
 }
 
 // Setter function for lazy string
@@ -120,7 +279,7 @@ void fscl_lazy_set_cstring(clazy *lazy, const char *value) {
     fscl_lazy_erase(lazy);  // Free existing memory if any
     lazy->is_evaluated = 1;
     size_t len = strlen(value);
-    lazy->data.string_value.data = malloc(len + 1);
+    lazy->data.string_value.data = fscl_alloc(lazy->allocator, len + 1);
     if (lazy->data.string_value.data == NULL) {
         puts("Allocation error encountered while allocating a string");  // Handle memory allocation failure
     }
@@ -128,16 +287,22 @@ void fscl_lazy_set_cstring(clazy *lazy, const char *value) {
     lazy->cache.memoized_string = lazy->data.string_value;
 }
 
-// Utility function to set the value of a lazy integer
-void fscl_lazy_set_bool(clazy *lazy, bool value) {
-    lazy->is_evaluated = 1;
-    lazy->data.bool_value = value;
-}
-
-// Utility function to set the value of a lazy integer
-void fscl_lazy_set_letter(clazy *lazy, char value) {
+// Setter function for lazy bytes
+void fscl_lazy_set_bytes(clazy *lazy, const void *data, size_t length) {
+    unsigned char *copy = NULL;
+    if (length > 0) {
+        copy = fscl_alloc(lazy->allocator, length);
+        if (copy == NULL) {
+            puts("Allocation error encountered while allocating a byte buffer");
+            length = 0;
+        } else {
+            memcpy(copy, data, length);
+        }
+    }
+    fscl_lazy_erase(lazy);  // Free existing memory if any
     lazy->is_evaluated = 1;
-    lazy->data.char_value = value;
+    lazy->data.bytes_value = (clazy_bytes){ copy, length };
+    lazy->cache.memoized_bytes = lazy->data.bytes_value;
 }
 
 // Utility function for conditional evaluation of lazy type
@@ -151,18 +316,21 @@ void fscl_lazy_conditional_eval(clazy *lazy, int condition) {
 void fscl_lazy_map_int(clazy *lazy, int (*mapFunction)(int)) {
     fscl_lazy_force(lazy);
     lazy->data.int_value = mapFunction(lazy->data.int_value);
+    lazy->cache.memoized_int = lazy->data.int_value;
 }
 
 // Utility function to map a function over a lazy bool
 void fscl_lazy_map_bool(clazy *lazy, bool (*mapFunction)(bool)) {
     fscl_lazy_force(lazy);
     lazy->data.bool_value = mapFunction(lazy->data.bool_value);
+    lazy->cache.memoized_bool = lazy->data.bool_value;
 }
 
 // Utility function to map a function over a lazy char
 void fscl_lazy_map_char(clazy *lazy, char (*mapFunction)(char)) {
     fscl_lazy_force(lazy);
     lazy->data.char_value = mapFunction(lazy->data.char_value);
+    lazy->cache.memoized_char = lazy->data.char_value;
 }
 
 // Utility function to map a function over a lazy string
@@ -170,8 +338,43 @@ void fscl_lazy_map_cstring(clazy *lazy, const char* (*mapFunction)(const char*))
     fscl_lazy_force(lazy);
     const char* result = mapFunction(lazy->data.string_value.data);
     size_t len = strlen(result);
-    lazy->data.string_value.data = realloc(lazy->data.string_value.data, len + 1);
+    size_t old_size = lazy->data.string_value.data != NULL ? strlen(lazy->data.string_value.data) + 1 : 0;
+    lazy->data.string_value.data = fscl_realloc(lazy->allocator, lazy->data.string_value.data, old_size, len + 1);
     strcpy(lazy->data.string_value.data, result);
+    lazy->cache.memoized_string = lazy->data.string_value;
+}
+
+// Utility function to map a function over a lazy 64-bit integer
+void fscl_lazy_map_int64(clazy *lazy, int64_t (*mapFunction)(int64_t)) {
+    fscl_lazy_force(lazy);
+    fscl_lazy_set_int64(lazy, mapFunction(lazy->data.int64_value));
+}
+
+// Utility function to map a function over a lazy unsigned 64-bit integer
+void fscl_lazy_map_uint64(clazy *lazy, uint64_t (*mapFunction)(uint64_t)) {
+    fscl_lazy_force(lazy);
+    fscl_lazy_set_uint64(lazy, mapFunction(lazy->data.uint64_value));
+}
+
+// Utility function to map a function over a lazy double
+void fscl_lazy_map_double(clazy *lazy, double (*mapFunction)(double)) {
+    fscl_lazy_force(lazy);
+    fscl_lazy_set_double(lazy, mapFunction(lazy->data.double_value));
+}
+
+// Utility function to map a function over a lazy pointer
+void fscl_lazy_map_pointer(clazy *lazy, void *(*mapFunction)(void *)) {
+    fscl_lazy_force(lazy);
+    fscl_lazy_set_pointer(lazy, mapFunction(lazy->data.pointer_value));
+}
+
+// Utility function to map a function over lazy bytes
+void fscl_lazy_map_bytes(clazy *lazy, clazy_view (*mapFunction)(clazy_view)) {
+    fscl_lazy_force(lazy);
+    clazy_view input = { (const char *)lazy->data.bytes_value.data, lazy->data.bytes_value.length };
+    clazy_view result = mapFunction(input);
+    // set_bytes copies before releasing the old buffer, so the result may alias it
+    fscl_lazy_set_bytes(lazy, result.data, result.length);
 }
 
 // Utility function for string concatenation of two lazy strings
@@ -182,9 +385,10 @@ void fscl_lazy_concat_cstrings(clazy *result, clazy *str1, clazy *str2) {
     size_t len1 = strlen(str1->cache.memoized_string.data);
     size_t len2 = strlen(str2->cache.memoized_string.data);
 
-    result->data.string_value.data = malloc(len1 + len2 + 1);
+    result->data.string_value.data = fscl_alloc(result->allocator, len1 + len2 + 1);
     strcpy(result->data.string_value.data, str1->cache.memoized_string.data);
     strcat(result->data.string_value.data, str2->cache.memoized_string.data);
+    result->cache.memoized_string = result->data.string_value;
 
     result->is_evaluated = 1;
     result->type = CLAZY_STRING;
@@ -206,6 +410,24 @@ void fscl_lazy_print(clazy *lazy) {
         case CLAZY_STRING:
             printf("Value (string): %s\n", lazy->data.string_value.data);
             break;
+        case CLAZY_FILE:
+            printf("Value (file): %zu bytes\n", lazy->data.view_value.length);
+            break;
+        case CLAZY_INT64:
+            printf("Value (int64): %lld\n", (long long)lazy->data.int64_value);
+            break;
+        case CLAZY_UINT64:
+            printf("Value (uint64): %llu\n", (unsigned long long)lazy->data.uint64_value);
+            break;
+        case CLAZY_DOUBLE:
+            printf("Value (double): %g\n", lazy->data.double_value);
+            break;
+        case CLAZY_POINTER:
+            printf("Value (pointer): %p\n", lazy->data.pointer_value);
+            break;
+        case CLAZY_BYTES:
+            printf("Value (bytes): %zu bytes\n", lazy->data.bytes_value.length);
+            break;
         default:
             printf("Unsupported type\n");
             break;
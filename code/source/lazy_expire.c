@@ -0,0 +1,202 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#define _POSIX_C_SOURCE 200809L
+#define _DARWIN_C_SOURCE
+#include "fossil/xpattern/lazy_expire.h"
+#include "fossil/xpattern/lazy_future.h"
+#include "xthread.h"
+#include <string.h>
+
+typedef struct {
+    fscl_mutex_t mutex;
+    fscl_cond_t changed;
+} expire_sync;
+
+#define EXPIRE_SYNC(expire) ((expire_sync *)(expire)->sync)
+
+static clazy expire_load(clazy_expire *expire) {
+    clazy fresh = fscl_lazy_create_thunk(expire->value.type, expire->thunk, expire->context);
+    fscl_lazy_force(&fresh);
+    return fresh;
+}
+
+static void expire_store(clazy_expire *expire, clazy fresh, unsigned long long started) {
+    fscl_lazy_erase(&expire->value);
+    expire->value = fresh;
+    expire->loaded_at = started;
+}
+
+static bool expire_is_fresh(const clazy_expire *expire, unsigned long long now) {
+    return expire->value.is_evaluated && (expire->ttl_ns == 0 || now - expire->loaded_at < expire->ttl_ns);
+}
+
+static bool expire_in_refresh_window(const clazy_expire *expire, unsigned long long now) {
+    if (expire->ttl_ns == 0 || expire->refresh_ahead_ns == 0) {
+        return false;
+    }
+    unsigned long long lead = expire->refresh_ahead_ns < expire->ttl_ns ? expire->ttl_ns - expire->refresh_ahead_ns : 0;
+    return now - expire->loaded_at >= lead;
+}
+
+static void expire_refresh(void *arg) {
+    clazy_expire *expire = arg;
+    fscl_mutex_lock(&EXPIRE_SYNC(expire)->mutex);
+    unsigned long generation = expire->generation;
+    fscl_mutex_unlock(&EXPIRE_SYNC(expire)->mutex);
+
+    unsigned long long started = fscl_time_ns();
+    clazy fresh = expire_load(expire);
+
+    fscl_mutex_lock(&EXPIRE_SYNC(expire)->mutex);
+    // An invalidate since the load started makes its result stale
+    if (generation == expire->generation) {
+        expire_store(expire, fresh, started);
+    } else {
+        fscl_lazy_erase(&fresh);
+    }
+    expire->refreshing = false;
+    fscl_cond_broadcast(&EXPIRE_SYNC(expire)->changed);
+    fscl_mutex_unlock(&EXPIRE_SYNC(expire)->mutex);
+}
+
+// Return with the lock held and a fresh (or still-serveable) value in place
+static void expire_acquire(clazy_expire *expire) {
+    expire_sync *sync = EXPIRE_SYNC(expire);
+    fscl_mutex_lock(&sync->mutex);
+    for (;;) {
+        unsigned long long now = fscl_time_ns();
+        if (expire_is_fresh(expire, now)) {
+            if (!expire->refreshing && expire_in_refresh_window(expire, now)) {
+                expire->refreshing = fscl_lazy_pool_submit(expire_refresh, expire);
+            }
+            return;
+        }
+
+        // Hard expiry: wait for whoever is already recomputing the value
+        if (expire->loading || expire->refreshing) {
+            fscl_cond_wait(&sync->changed, &sync->mutex);
+            continue;
+        }
+
+        unsigned long generation = expire->generation;
+        expire->loading = true;
+        fscl_mutex_unlock(&sync->mutex);
+        clazy fresh = expire_load(expire);
+        fscl_mutex_lock(&sync->mutex);
+
+        expire->loading = false;
+        fscl_cond_broadcast(&sync->changed);
+        if (generation != expire->generation) {
+            fscl_lazy_erase(&fresh);
+            continue;
+        }
+        expire_store(expire, fresh, now);
+        return;
+    }
+}
+
+static void expire_release(clazy_expire *expire) {
+    fscl_mutex_unlock(&EXPIRE_SYNC(expire)->mutex);
+}
+
+bool fscl_lazy_expire_create(clazy_expire *expire, clazy_type type, clazy_thunk thunk, void *context,
+                             unsigned long ttl_ms, unsigned long refresh_ahead_ms) {
+    expire->value = fscl_lazy_create(type);
+    expire->thunk = thunk;
+    expire->context = context;
+    expire->ttl_ns = (unsigned long long)ttl_ms * 1000000ULL;
+    expire->refresh_ahead_ns = (unsigned long long)refresh_ahead_ms * 1000000ULL;
+    expire->loaded_at = 0;
+    expire->loading = false;
+    expire->refreshing = false;
+    expire->generation = 0;
+
+    expire->allocator = fscl_alloc_default();
+    expire_sync *sync = fscl_alloc(expire->allocator, sizeof(expire_sync));
+    expire->sync = sync;
+    if (sync == NULL) {
+        return false;
+    }
+    fscl_mutex_init(&sync->mutex);
+    fscl_cond_init(&sync->changed);
+    return true;
+}
+
+void fscl_lazy_expire_erase(clazy_expire *expire) {
+    expire_sync *sync = EXPIRE_SYNC(expire);
+    if (sync == NULL) {
+        return;
+    }
+
+    fscl_mutex_lock(&sync->mutex);
+    while (expire->loading || expire->refreshing) {
+        fscl_cond_wait(&sync->changed, &sync->mutex);
+    }
+    fscl_lazy_erase(&expire->value);
+    fscl_mutex_unlock(&sync->mutex);
+
+    fscl_cond_destroy(&sync->changed);
+    fscl_mutex_destroy(&sync->mutex);
+    fscl_free(expire->allocator, sync, sizeof(expire_sync));
+    expire->sync = NULL;
+}
+
+int fscl_lazy_expire_force_int(clazy_expire *expire) {
+    expire_acquire(expire);
+    int value = expire->value.cache.memoized_int;
+    expire_release(expire);
+    return value;
+}
+
+bool fscl_lazy_expire_force_bool(clazy_expire *expire) {
+    expire_acquire(expire);
+    bool value = expire->value.cache.memoized_bool;
+    expire_release(expire);
+    return value;
+}
+
+char fscl_lazy_expire_force_char(clazy_expire *expire) {
+    expire_acquire(expire);
+    char value = expire->value.cache.memoized_char;
+    expire_release(expire);
+    return value;
+}
+
+size_t fscl_lazy_expire_force_string(clazy_expire *expire, char *buffer, size_t size) {
+    expire_acquire(expire);
+    const char *value = expire->value.cache.memoized_string.data;
+    size_t length = value != NULL ? strlen(value) : 0;
+    if (size > 0) {
+        size_t copy = length < size - 1 ? length : size - 1;
+        if (copy > 0) {
+            memcpy(buffer, value, copy);
+        }
+        buffer[copy] = '\0';
+    }
+    expire_release(expire);
+    return length;
+}
+
+void fscl_lazy_expire_invalidate(clazy_expire *expire) {
+    fscl_mutex_lock(&EXPIRE_SYNC(expire)->mutex);
+    fscl_lazy_erase(&expire->value);
+    expire->generation++;
+    fscl_mutex_unlock(&EXPIRE_SYNC(expire)->mutex);
+}
+
+bool fscl_lazy_expire_is_stale(clazy_expire *expire) {
+    fscl_mutex_lock(&EXPIRE_SYNC(expire)->mutex);
+    bool stale = !expire_is_fresh(expire, fscl_time_ns());
+    fscl_mutex_unlock(&EXPIRE_SYNC(expire)->mutex);
+    return stale;
+}
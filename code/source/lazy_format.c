@@ -0,0 +1,580 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#define _POSIX_C_SOURCE 200809L
+#include "fossil/xpattern/lazy_format.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define SNAPSHOT_MAGIC "FLZS"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_EVALUATED 0x01
+#define SNAPSHOT_NULL_STRING 0x02
+
+// =================================================================
+// Sinks
+// =================================================================
+
+static bool sink_write_fd(int fd, const char *data, size_t length) {
+    while (length > 0) {
+#ifdef _WIN32
+        int written = _write(fd, data, length > 0x7fffffff ? 0x7fffffff : (unsigned int)length);
+#else
+        ssize_t written = write(fd, data, length);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+// Hand data to the sink's target; buffer sinks have none and fail
+static bool sink_emit(clazy_sink *sink, const char *data, size_t length) {
+    bool ok = false;
+    if (sink->fd >= 0) {
+        ok = sink_write_fd(sink->fd, data, length);
+    } else if (sink->flush != NULL) {
+        ok = sink->flush(sink->context, data, length);
+    }
+    if (!ok) {
+        sink->failed = true;
+    }
+    return ok;
+}
+
+static void sink_init(clazy_sink *sink, char *buffer, size_t size) {
+    sink->buffer = buffer;
+    sink->size = size;
+    sink->length = 0;
+    sink->flush = NULL;
+    sink->context = NULL;
+    sink->fd = -1;
+    sink->failed = false;
+}
+
+void fscl_lazy_sink_buffer(clazy_sink *sink, char *buffer, size_t size) {
+    sink_init(sink, buffer, size);
+}
+
+void fscl_lazy_sink_fd(clazy_sink *sink, int fd, char *buffer, size_t size) {
+    sink_init(sink, buffer, size);
+    sink->fd = fd;
+}
+
+void fscl_lazy_sink_callback(clazy_sink *sink, clazy_sink_flush flush, void *context, char *buffer, size_t size) {
+    sink_init(sink, buffer, size);
+    sink->flush = flush;
+    sink->context = context;
+}
+
+bool fscl_lazy_sink_flush(clazy_sink *sink) {
+    if (sink->failed) {
+        return false;
+    }
+    if (sink->length == 0 || (sink->fd < 0 && sink->flush == NULL)) {
+        return true;
+    }
+    bool ok = sink_emit(sink, sink->buffer, sink->length);
+    sink->length = 0;
+    return ok;
+}
+
+bool fscl_lazy_sink_write(clazy_sink *sink, const void *data, size_t length) {
+    const char *bytes = data;
+    if (sink->failed) {
+        return false;
+    }
+
+    // Large writes bypass the staging buffer entirely
+    if (length >= sink->size && (sink->fd >= 0 || sink->flush != NULL)) {
+        return fscl_lazy_sink_flush(sink) && sink_emit(sink, bytes, length);
+    }
+
+    while (length > 0) {
+        size_t space = sink->size - sink->length;
+        if (space == 0) {
+            if (sink->fd < 0 && sink->flush == NULL) {
+                sink->failed = true;
+                return false;
+            }
+            if (!fscl_lazy_sink_flush(sink)) {
+                return false;
+            }
+            space = sink->size;
+        }
+        size_t chunk = length < space ? length : space;
+        memcpy(sink->buffer + sink->length, bytes, chunk);
+        sink->length += chunk;
+        bytes += chunk;
+        length -= chunk;
+    }
+    return true;
+}
+
+// =================================================================
+// Formatting
+// =================================================================
+
+static const char format_digits[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Write the decimal digits of value to out (at least 20 bytes), two at a time
+static size_t format_u64(char *out, uint64_t value) {
+    char digits[20];
+    size_t pos = sizeof(digits);
+    while (value >= 100) {
+        size_t pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        digits[--pos] = format_digits[pair + 1];
+        digits[--pos] = format_digits[pair];
+    }
+    if (value >= 10) {
+        size_t pair = (size_t)value * 2;
+        digits[--pos] = format_digits[pair + 1];
+        digits[--pos] = format_digits[pair];
+    } else {
+        digits[--pos] = (char)('0' + value);
+    }
+    memcpy(out, digits + pos, sizeof(digits) - pos);
+    return sizeof(digits) - pos;
+}
+
+static size_t format_i64(char *out, int64_t value) {
+    if (value < 0) {
+        out[0] = '-';
+        return 1 + format_u64(out + 1, (uint64_t)0 - (uint64_t)value);
+    }
+    return format_u64(out, (uint64_t)value);
+}
+
+static size_t format_hex(char *out, uintptr_t value) {
+    static const char hex[] = "0123456789abcdef";
+    char digits[2 * sizeof(uintptr_t)];
+    size_t pos = sizeof(digits);
+    do {
+        digits[--pos] = hex[value & 0xf];
+        value >>= 4;
+    } while (value != 0);
+    out[0] = '0';
+    out[1] = 'x';
+    memcpy(out + 2, digits + pos, sizeof(digits) - pos);
+    return 2 + sizeof(digits) - pos;
+}
+
+// Formatted output goes either to a sink or to a bounded buffer that
+// still counts the full length, like snprintf
+typedef struct {
+    clazy_sink *sink;
+    char *buffer;
+    size_t size;
+    size_t length;
+} format_out;
+
+static void format_put(format_out *out, const char *data, size_t length) {
+    if (out->sink != NULL) {
+        fscl_lazy_sink_write(out->sink, data, length);
+    } else if (out->length + 1 < out->size) {
+        size_t room = out->size - 1 - out->length;
+        memcpy(out->buffer + out->length, data, length < room ? length : room);
+    }
+    out->length += length;
+}
+
+static void format_value(format_out *out, clazy *lazy) {
+    char scratch[40];
+    size_t n;
+
+    fscl_lazy_force(lazy);
+    switch (lazy->type) {
+        case CLAZY_INT:
+            format_put(out, scratch, format_i64(scratch, lazy->cache.memoized_int));
+            break;
+        case CLAZY_BOOL:
+            format_put(out, lazy->cache.memoized_bool ? "true" : "false", lazy->cache.memoized_bool ? 4 : 5);
+            break;
+        case CLAZY_CHAR:
+            format_put(out, &lazy->cache.memoized_char, 1);
+            break;
+        case CLAZY_STRING:
+            if (lazy->cache.memoized_string.data != NULL) {
+                format_put(out, lazy->cache.memoized_string.data, strlen(lazy->cache.memoized_string.data));
+            }
+            break;
+        case CLAZY_FILE:
+            format_put(out, lazy->cache.memoized_view.data, lazy->cache.memoized_view.length);
+            break;
+        case CLAZY_INT64:
+            format_put(out, scratch, format_i64(scratch, lazy->cache.memoized_int64));
+            break;
+        case CLAZY_UINT64:
+            format_put(out, scratch, format_u64(scratch, lazy->cache.memoized_uint64));
+            break;
+        case CLAZY_DOUBLE:
+            // snprintf formats into memory and takes no stream lock
+            n = (size_t)snprintf(scratch, sizeof(scratch), "%.17g", lazy->cache.memoized_double);
+            format_put(out, scratch, n < sizeof(scratch) ? n : sizeof(scratch) - 1);
+            break;
+        case CLAZY_POINTER:
+            format_put(out, scratch, format_hex(scratch, (uintptr_t)lazy->cache.memoized_pointer));
+            break;
+        case CLAZY_BYTES: {
+            static const char hex[] = "0123456789abcdef";
+            const unsigned char *bytes = lazy->cache.memoized_bytes.data;
+            size_t remaining = lazy->cache.memoized_bytes.length;
+            while (remaining > 0) {
+                size_t chunk = remaining < sizeof(scratch) / 2 ? remaining : sizeof(scratch) / 2;
+                for (size_t i = 0; i < chunk; ++i) {
+                    scratch[2 * i] = hex[bytes[i] >> 4];
+                    scratch[2 * i + 1] = hex[bytes[i] & 0xf];
+                }
+                format_put(out, scratch, 2 * chunk);
+                bytes += chunk;
+                remaining -= chunk;
+            }
+            break;
+        }
+        default:
+            format_put(out, "null", 4);
+            break;
+    }
+}
+
+size_t fscl_lazy_format(clazy *lazy, char *buffer, size_t size) {
+    format_out out = { NULL, buffer, size, 0 };
+    format_value(&out, lazy);
+    if (size > 0) {
+        buffer[out.length < size ? out.length : size - 1] = '\0';
+    }
+    return out.length;
+}
+
+bool fscl_lazy_write(clazy_sink *sink, clazy *lazy) {
+    format_out out = { sink, NULL, 0, 0 };
+    format_value(&out, lazy);
+    return !sink->failed;
+}
+
+// =================================================================
+// Binary Snapshots
+// =================================================================
+
+static void snapshot_put_varint(clazy_sink *sink, uint64_t value) {
+    unsigned char bytes[10];
+    size_t n = 0;
+    while (value >= 0x80) {
+        bytes[n++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    bytes[n++] = (unsigned char)value;
+    fscl_lazy_sink_write(sink, bytes, n);
+}
+
+static void snapshot_put_signed(clazy_sink *sink, int64_t value) {
+    snapshot_put_varint(sink, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static void snapshot_put_double(clazy_sink *sink, double value) {
+    uint64_t bits;
+    unsigned char bytes[8];
+    memcpy(&bits, &value, sizeof(bits));
+    for (size_t i = 0; i < 8; ++i) {
+        bytes[i] = (unsigned char)(bits >> (8 * i));
+    }
+    fscl_lazy_sink_write(sink, bytes, sizeof(bytes));
+}
+
+static bool snapshot_is_saved(const clazy *lazy) {
+    return lazy->is_evaluated && lazy->type != CLAZY_POINTER && lazy->type != CLAZY_FILE && lazy->type != CLAZY_NULL;
+}
+
+bool fscl_lazy_snapshot_save(clazy_sink *sink, clazy *items, size_t count) {
+    unsigned char version = SNAPSHOT_VERSION;
+    fscl_lazy_sink_write(sink, SNAPSHOT_MAGIC, 4);
+    fscl_lazy_sink_write(sink, &version, 1);
+    snapshot_put_varint(sink, count);
+
+    for (size_t i = 0; i < count; ++i) {
+        clazy *lazy = &items[i];
+        unsigned char record[2] = { (unsigned char)lazy->type, 0 };
+        if (!snapshot_is_saved(lazy)) {
+            fscl_lazy_sink_write(sink, record, 2);
+            continue;
+        }
+
+        record[1] = SNAPSHOT_EVALUATED;
+        if (lazy->type == CLAZY_STRING && lazy->cache.memoized_string.data == NULL) {
+            record[1] |= SNAPSHOT_NULL_STRING;
+        }
+        fscl_lazy_sink_write(sink, record, 2);
+
+        switch (lazy->type) {
+            case CLAZY_INT:
+                snapshot_put_signed(sink, lazy->cache.memoized_int);
+                break;
+            case CLAZY_BOOL:
+                snapshot_put_varint(sink, lazy->cache.memoized_bool ? 1 : 0);
+                break;
+            case CLAZY_CHAR:
+                fscl_lazy_sink_write(sink, &lazy->cache.memoized_char, 1);
+                break;
+            case CLAZY_STRING:
+                if (lazy->cache.memoized_string.data != NULL) {
+                    size_t length = strlen(lazy->cache.memoized_string.data);
+                    snapshot_put_varint(sink, length);
+                    fscl_lazy_sink_write(sink, lazy->cache.memoized_string.data, length);
+                }
+                break;
+            case CLAZY_INT64:
+                snapshot_put_signed(sink, lazy->cache.memoized_int64);
+                break;
+            case CLAZY_UINT64:
+                snapshot_put_varint(sink, lazy->cache.memoized_uint64);
+                break;
+            case CLAZY_DOUBLE:
+                snapshot_put_double(sink, lazy->cache.memoized_double);
+                break;
+            case CLAZY_BYTES:
+                snapshot_put_varint(sink, lazy->cache.memoized_bytes.length);
+                fscl_lazy_sink_write(sink, lazy->cache.memoized_bytes.data, lazy->cache.memoized_bytes.length);
+                break;
+            default:
+                break;
+        }
+    }
+    return fscl_lazy_sink_flush(sink);
+}
+
+typedef struct {
+    const unsigned char *data;
+    size_t length;
+    size_t pos;
+} snapshot_reader;
+
+static bool snapshot_get_varint(snapshot_reader *reader, uint64_t *value) {
+    uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (reader->pos >= reader->length) {
+            return false;
+        }
+        unsigned char byte = reader->data[reader->pos++];
+        result |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool snapshot_get_signed(snapshot_reader *reader, int64_t *value) {
+    uint64_t raw;
+    if (!snapshot_get_varint(reader, &raw)) {
+        return false;
+    }
+    *value = (int64_t)(raw >> 1) ^ -(int64_t)(raw & 1);
+    return true;
+}
+
+static bool snapshot_get_bytes(snapshot_reader *reader, const unsigned char **bytes, size_t *length) {
+    uint64_t size;
+    if (!snapshot_get_varint(reader, &size) || size > reader->length - reader->pos) {
+        return false;
+    }
+    *bytes = reader->data + reader->pos;
+    *length = (size_t)size;
+    reader->pos += (size_t)size;
+    return true;
+}
+
+static void snapshot_set_string(clazy *lazy, const unsigned char *bytes, size_t length, bool is_null) {
+    char *copy = NULL;
+    if (!is_null) {
+        copy = fscl_alloc(lazy->allocator, length + 1);
+        if (copy == NULL) {
+            return;
+        }
+        memcpy(copy, bytes, length);
+        copy[length] = '\0';
+    }
+    fscl_lazy_erase(lazy);
+    lazy->data.string_value.data = copy;
+    lazy->cache.memoized_string = lazy->data.string_value;
+    lazy->is_evaluated = 1;
+}
+
+bool fscl_lazy_snapshot_load(const void *data, size_t length, clazy *items, size_t capacity, size_t *restored) {
+    snapshot_reader reader = { data, length, 0 };
+    size_t warmed = 0;
+    uint64_t count;
+
+    if (restored != NULL) {
+        *restored = 0;
+    }
+    if (length < 5 || memcmp(data, SNAPSHOT_MAGIC, 4) != 0 || reader.data[4] != SNAPSHOT_VERSION) {
+        return false;
+    }
+    reader.pos = 5;
+    if (!snapshot_get_varint(&reader, &count)) {
+        return false;
+    }
+
+    for (uint64_t i = 0; i < count; ++i) {
+        if (reader.length - reader.pos < 2) {
+            return false;
+        }
+        clazy_type type = (clazy_type)reader.data[reader.pos];
+        unsigned char flags = reader.data[reader.pos + 1];
+        reader.pos += 2;
+        if (!(flags & SNAPSHOT_EVALUATED)) {
+            continue;
+        }
+
+        clazy *target = (i < capacity && items[i].type == type) ? &items[i] : NULL;
+        int64_t number = 0;
+        uint64_t unsigned_number = 0;
+        const unsigned char *bytes = NULL;
+        size_t size = 0;
+
+        switch (type) {
+            case CLAZY_INT:
+                if (!snapshot_get_signed(&reader, &number)) {
+                    return false;
+                }
+                if (target != NULL) {
+                    fscl_lazy_erase(target);
+                    fscl_lazy_set_int(target, (int)number);
+                }
+                break;
+            case CLAZY_BOOL:
+                if (!snapshot_get_varint(&reader, &unsigned_number)) {
+                    return false;
+                }
+                if (target != NULL) {
+                    fscl_lazy_erase(target);
+                    fscl_lazy_set_bool(target, unsigned_number != 0);
+                }
+                break;
+            case CLAZY_CHAR:
+                if (reader.pos >= reader.length) {
+                    return false;
+                }
+                if (target != NULL) {
+                    fscl_lazy_erase(target);
+                    fscl_lazy_set_letter(target, (char)reader.data[reader.pos]);
+                }
+                reader.pos++;
+                break;
+            case CLAZY_STRING:
+                if (!(flags & SNAPSHOT_NULL_STRING) && !snapshot_get_bytes(&reader, &bytes, &size)) {
+                    return false;
+                }
+                if (target != NULL) {
+                    snapshot_set_string(target, bytes, size, (flags & SNAPSHOT_NULL_STRING) != 0);
+                }
+                break;
+            case CLAZY_INT64:
+                if (!snapshot_get_signed(&reader, &number)) {
+                    return false;
+                }
+                if (target != NULL) {
+                    fscl_lazy_erase(target);
+                    fscl_lazy_set_int64(target, number);
+                }
+                break;
+            case CLAZY_UINT64:
+                if (!snapshot_get_varint(&reader, &unsigned_number)) {
+                    return false;
+                }
+                if (target != NULL) {
+                    fscl_lazy_erase(target);
+                    fscl_lazy_set_uint64(target, unsigned_number);
+                }
+                break;
+            case CLAZY_DOUBLE:
+                if (reader.length - reader.pos < 8) {
+                    return false;
+                }
+                for (size_t b = 0; b < 8; ++b) {
+                    unsigned_number |= (uint64_t)reader.data[reader.pos + b] << (8 * b);
+                }
+                reader.pos += 8;
+                if (target != NULL) {
+                    double value;
+                    memcpy(&value, &unsigned_number, sizeof(value));
+                    fscl_lazy_erase(target);
+                    fscl_lazy_set_double(target, value);
+                }
+                break;
+            case CLAZY_BYTES:
+                if (!snapshot_get_bytes(&reader, &bytes, &size)) {
+                    return false;
+                }
+                if (target != NULL) {
+                    fscl_lazy_set_bytes(target, bytes, size);
+                }
+                break;
+            default:
+                // Pointers, files and nulls are never saved with a value
+                return false;
+        }
+        if (target != NULL && target->is_evaluated) {
+            warmed++;
+        }
+    }
+
+    if (restored != NULL) {
+        *restored = warmed;
+    }
+    return true;
+}
+
+static bool snapshot_flush_file(void *context, const char *data, size_t length) {
+    return fwrite(data, 1, length, (FILE *)context) == length;
+}
+
+bool fscl_lazy_snapshot_save_file(const char *path, clazy *items, size_t count) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    char buffer[16384];
+    clazy_sink sink;
+    fscl_lazy_sink_callback(&sink, snapshot_flush_file, file, buffer, sizeof(buffer));
+    bool ok = fscl_lazy_snapshot_save(&sink, items, count);
+    return fclose(file) == 0 && ok;
+}
+
+bool fscl_lazy_snapshot_load_file(const char *path, clazy *items, size_t capacity, size_t *restored) {
+    clazy file = fscl_lazy_create_file(path);
+    clazy_view view = fscl_lazy_force_view(&file);
+    bool ok = view.data != NULL && fscl_lazy_snapshot_load(view.data, view.length, items, capacity, restored);
+    fscl_lazy_erase(&file);
+    return ok;
+}
@@ -0,0 +1,259 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#define _POSIX_C_SOURCE 200809L
+#define _DARWIN_C_SOURCE
+#include "fossil/xpattern/lazy_future.h"
+#include "xthread.h"
+#include <stdlib.h>
+
+struct clazy_future {
+    fscl_mutex_t lock;
+    fscl_cond_t done_cond;
+    int done;
+    clazy *lazy;
+    const callocator *allocator;  // The lazy object's allocator at spawn
+};
+
+typedef struct {
+    void (*task)(void *arg);
+    void *arg;
+} pool_task;
+
+// Shared worker pool with a growable ring of queued tasks
+static struct {
+    fscl_mutex_t lock;
+    fscl_cond_t wake;
+    fscl_thread_t *threads;
+    size_t workers;
+    pool_task *tasks;
+    size_t head;
+    size_t count;
+    size_t capacity;
+    bool running;
+    bool stopping;
+} pool = { FSCL_MUTEX_INITIALIZER, FSCL_COND_INITIALIZER, NULL, 0, NULL, 0, 0, 0, false, false };
+
+static void pool_worker(void *arg) {
+    (void)arg;
+    fscl_mutex_lock(&pool.lock);
+    for (;;) {
+        while (pool.count == 0 && !pool.stopping) {
+            fscl_cond_wait(&pool.wake, &pool.lock);
+        }
+        if (pool.count == 0) {
+            break;
+        }
+        pool_task task = pool.tasks[pool.head];
+        pool.head = (pool.head + 1) % pool.capacity;
+        pool.count--;
+        fscl_mutex_unlock(&pool.lock);
+
+        task.task(task.arg);
+
+        fscl_mutex_lock(&pool.lock);
+    }
+    fscl_mutex_unlock(&pool.lock);
+}
+
+static bool pool_start_locked(size_t workers) {
+    if (pool.running) {
+        return true;
+    }
+    if (workers == 0) {
+        workers = fscl_cpu_count();
+    }
+
+    pool.threads = malloc(workers * sizeof(fscl_thread_t));
+    if (pool.threads == NULL) {
+        return false;
+    }
+
+    pool.workers = 0;
+    for (size_t i = 0; i < workers; ++i) {
+        if (!fscl_thread_create(&pool.threads[pool.workers], pool_worker, NULL)) {
+            break;
+        }
+        pool.workers++;
+    }
+    if (pool.workers == 0) {
+        free(pool.threads);
+        pool.threads = NULL;
+        return false;
+    }
+
+    pool.running = true;
+    return true;
+}
+
+// Double the ring, unwrapping queued tasks to the front of the new buffer
+static bool pool_grow_locked(void) {
+    size_t capacity = pool.capacity ? pool.capacity * 2 : 64;
+    pool_task *tasks = malloc(capacity * sizeof(pool_task));
+    if (tasks == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < pool.count; ++i) {
+        tasks[i] = pool.tasks[(pool.head + i) % pool.capacity];
+    }
+    free(pool.tasks);
+    pool.tasks = tasks;
+    pool.head = 0;
+    pool.capacity = capacity;
+    return true;
+}
+
+bool fscl_lazy_pool_start(size_t workers) {
+    fscl_mutex_lock(&pool.lock);
+    bool running = pool_start_locked(workers);
+    fscl_mutex_unlock(&pool.lock);
+    return running;
+}
+
+void fscl_lazy_pool_stop(void) {
+    fscl_mutex_lock(&pool.lock);
+    if (!pool.running || pool.stopping) {
+        fscl_mutex_unlock(&pool.lock);
+        return;
+    }
+    pool.stopping = true;
+    fscl_cond_broadcast(&pool.wake);
+    fscl_mutex_unlock(&pool.lock);
+
+    for (size_t i = 0; i < pool.workers; ++i) {
+        fscl_thread_join(pool.threads[i]);
+    }
+
+    fscl_mutex_lock(&pool.lock);
+    free(pool.threads);
+    pool.threads = NULL;
+    pool.workers = 0;
+    pool.running = false;
+    pool.stopping = false;
+    fscl_mutex_unlock(&pool.lock);
+}
+
+bool fscl_lazy_pool_submit(void (*task)(void *arg), void *arg) {
+    fscl_mutex_lock(&pool.lock);
+    if (pool.stopping || !pool_start_locked(0)) {
+        fscl_mutex_unlock(&pool.lock);
+        return false;
+    }
+    if (pool.count == pool.capacity && !pool_grow_locked()) {
+        fscl_mutex_unlock(&pool.lock);
+        return false;
+    }
+    pool.tasks[(pool.head + pool.count) % pool.capacity] = (pool_task){ task, arg };
+    pool.count++;
+    fscl_cond_signal(&pool.wake);
+    fscl_mutex_unlock(&pool.lock);
+    return true;
+}
+
+size_t fscl_lazy_pool_workers(void) {
+    fscl_mutex_lock(&pool.lock);
+    size_t workers = pool.running ? pool.workers : 0;
+    fscl_mutex_unlock(&pool.lock);
+    return workers;
+}
+
+// Evaluate into a detached copy so the worker never waits on its own future
+static void future_run(void *arg) {
+    clazy_future *future = arg;
+    clazy *lazy = future->lazy;
+
+    clazy scratch = *lazy;
+    scratch.future = NULL;
+    fscl_lazy_force(&scratch);
+    lazy->data = scratch.data;
+    lazy->cache = scratch.cache;
+
+    fscl_mutex_lock(&future->lock);
+    future->done = 1;
+    fscl_cond_broadcast(&future->done_cond);
+    fscl_mutex_unlock(&future->lock);
+}
+
+bool fscl_lazy_spawn(clazy *lazy) {
+    if (lazy->is_evaluated || lazy->future != NULL) {
+        return true;
+    }
+
+    clazy_future *future = fscl_alloc(lazy->allocator, sizeof(clazy_future));
+    if (future == NULL) {
+        fscl_lazy_force(lazy);
+        return false;
+    }
+    future->allocator = lazy->allocator;
+    fscl_mutex_init(&future->lock);
+    fscl_cond_init(&future->done_cond);
+    future->done = 0;
+    future->lazy = lazy;
+    lazy->future = future;
+
+    if (!fscl_lazy_pool_submit(future_run, future)) {
+        future_run(future);
+        fscl_lazy_await(lazy);
+        return false;
+    }
+    return true;
+}
+
+void fscl_lazy_await(clazy *lazy) {
+    clazy_future *future = lazy->future;
+    if (future == NULL) {
+        return;
+    }
+
+    fscl_mutex_lock(&future->lock);
+    while (!future->done) {
+        fscl_cond_wait(&future->done_cond, &future->lock);
+    }
+    fscl_mutex_unlock(&future->lock);
+
+    fscl_cond_destroy(&future->done_cond);
+    fscl_mutex_destroy(&future->lock);
+    fscl_free(future->allocator, future, sizeof(clazy_future));
+    lazy->future = NULL;
+    lazy->is_evaluated = 1;
+}
+
+bool fscl_lazy_try_force(clazy *lazy) {
+    if (lazy->future == NULL) {
+        if (lazy->is_evaluated) {
+            return true;
+        }
+        if (!fscl_lazy_spawn(lazy)) {
+            return true;
+        }
+    }
+
+    clazy_future *future = lazy->future;
+    fscl_mutex_lock(&future->lock);
+    int done = future->done;
+    fscl_mutex_unlock(&future->lock);
+
+    if (done) {
+        fscl_lazy_await(lazy);
+        return true;
+    }
+    return false;
+}
+
+void fscl_lazy_when_all(clazy **lazies, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        fscl_lazy_spawn(lazies[i]);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        fscl_lazy_force(lazies[i]);
+    }
+}
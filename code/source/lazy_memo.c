@@ -0,0 +1,321 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#define _POSIX_C_SOURCE 200809L
+#define _DARWIN_C_SOURCE
+#include "fossil/xpattern/lazy_memo.h"
+#include "xthread.h"
+#include <stdint.h>
+#include <string.h>
+
+// Hash an integer key (lowbias32 finalizer)
+static size_t memo_hash_int(int key) {
+    uint32_t x = (uint32_t)key;
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return (size_t)x;
+}
+
+// Hash a string key (FNV-1a)
+static size_t memo_hash_cstring(const char *key) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    while (*key) {
+        h ^= (unsigned char)*key++;
+        h *= 0x100000001b3ULL;
+    }
+    return (size_t)(h ^ (h >> 32));
+}
+
+static char *memo_strdup(clazy_memo *memo, const char *value) {
+    size_t len = strlen(value);
+    char *copy = fscl_alloc(memo->allocator, len + 1);
+    if (copy != NULL) {
+        memcpy(copy, value, len + 1);
+    }
+    return copy;
+}
+
+static void memo_lock(clazy_memo *memo) {
+    if (memo->lock != NULL) {
+        fscl_mutex_lock((fscl_mutex_t *)memo->lock);
+    }
+}
+
+static void memo_unlock(clazy_memo *memo) {
+    if (memo->lock != NULL) {
+        fscl_mutex_unlock((fscl_mutex_t *)memo->lock);
+    }
+}
+
+static bool memo_create(clazy_memo *memo, clazy_type type, size_t capacity, bool thread_safe) {
+    if (capacity == 0) {
+        capacity = 1;
+    }
+
+    // Keep the load factor at or below one half so probe runs stay short
+    size_t slots = 8;
+    while (slots < capacity * 2) {
+        slots <<= 1;
+    }
+
+    memo->type = type;
+    memo->allocator = fscl_alloc_default();
+    memo->entries = fscl_alloc(memo->allocator, slots * sizeof(clazy_memo_entry));
+    memo->mask = slots - 1;
+    memo->capacity = capacity;
+    memo->count = 0;
+    memo->hand = 0;
+    memo->hits = 0;
+    memo->misses = 0;
+    memo->evictions = 0;
+    memo->lock = NULL;
+
+    if (memo->entries == NULL) {
+        return false;
+    }
+    memset(memo->entries, 0, slots * sizeof(clazy_memo_entry));
+
+    if (thread_safe) {
+        memo->lock = fscl_alloc(memo->allocator, sizeof(fscl_mutex_t));
+        if (memo->lock == NULL) {
+            fscl_free(memo->allocator, memo->entries, slots * sizeof(clazy_memo_entry));
+            memo->entries = NULL;
+            return false;
+        }
+        fscl_mutex_init((fscl_mutex_t *)memo->lock);
+    }
+    return true;
+}
+
+static bool memo_key_equal(const clazy_memo *memo, const clazy_memo_entry *entry, int int_key, const char *string_key, size_t hash) {
+    if (entry->hash != hash) {
+        return false;
+    }
+    if (memo->type == CLAZY_STRING) {
+        return strcmp(entry->key.string_key, string_key) == 0;
+    }
+    return entry->key.int_key == int_key;
+}
+
+// Find the slot holding the key, or the empty slot where it belongs
+static size_t memo_find(const clazy_memo *memo, int int_key, const char *string_key, size_t hash) {
+    size_t i = hash & memo->mask;
+    while (memo->entries[i].used && !memo_key_equal(memo, &memo->entries[i], int_key, string_key, hash)) {
+        i = (i + 1) & memo->mask;
+    }
+    return i;
+}
+
+static void memo_free_string(clazy_memo *memo, char *value) {
+    if (value != NULL) {
+        fscl_free(memo->allocator, value, strlen(value) + 1);
+    }
+}
+
+static void memo_release(clazy_memo *memo, clazy_memo_entry *entry) {
+    if (memo->type == CLAZY_STRING) {
+        memo_free_string(memo, entry->key.string_key);
+        memo_free_string(memo, entry->value.string_value);
+    }
+    entry->used = 0;
+}
+
+// Remove slot i with backward-shift deletion so no tombstones are needed
+static void memo_remove(clazy_memo *memo, size_t i) {
+    memo_release(memo, &memo->entries[i]);
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & memo->mask;
+        if (!memo->entries[j].used) {
+            break;
+        }
+        size_t home = memo->entries[j].hash & memo->mask;
+        bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (stays) {
+            continue;
+        }
+        memo->entries[i] = memo->entries[j];
+        memo->entries[j].used = 0;
+        i = j;
+    }
+    memo->count--;
+}
+
+// Evict one entry using the CLOCK second-chance policy
+static void memo_evict(clazy_memo *memo) {
+    for (;;) {
+        clazy_memo_entry *entry = &memo->entries[memo->hand];
+        if (entry->used) {
+            if (!entry->referenced) {
+                memo_remove(memo, memo->hand);
+                memo->evictions++;
+                return;
+            }
+            entry->referenced = 0;
+        }
+        memo->hand = (memo->hand + 1) & memo->mask;
+    }
+}
+
+// Insert a computed result, returning the entry that now holds the key
+static clazy_memo_entry *memo_insert(clazy_memo *memo, int int_key, const char *string_key, size_t hash, int int_value, const char *string_value) {
+    size_t i = memo_find(memo, int_key, string_key, hash);
+    if (memo->entries[i].used) {
+        // Another thread filled the key while the function ran unlocked
+        return &memo->entries[i];
+    }
+
+    if (memo->count >= memo->capacity) {
+        memo_evict(memo);
+        i = memo_find(memo, int_key, string_key, hash);
+    }
+
+    clazy_memo_entry *entry = &memo->entries[i];
+    if (memo->type == CLAZY_STRING) {
+        entry->key.string_key = memo_strdup(memo, string_key);
+        entry->value.string_value = memo_strdup(memo, string_value);
+        if (entry->key.string_key == NULL || entry->value.string_value == NULL) {
+            memo_free_string(memo, entry->key.string_key);
+            memo_free_string(memo, entry->value.string_value);
+            return NULL;
+        }
+    } else {
+        entry->key.int_key = int_key;
+        entry->value.int_value = int_value;
+    }
+    entry->hash = hash;
+    entry->used = 1;
+    entry->referenced = 0;
+    memo->count++;
+    return entry;
+}
+
+bool fscl_lazy_memo_create_int(clazy_memo *memo, int (*mapFunction)(int), size_t capacity, bool thread_safe) {
+    memo->function.map_int = mapFunction;
+    return memo_create(memo, CLAZY_INT, capacity, thread_safe);
+}
+
+bool fscl_lazy_memo_create_cstring(clazy_memo *memo, const char *(*mapFunction)(const char *), size_t capacity, bool thread_safe) {
+    memo->function.map_cstring = mapFunction;
+    return memo_create(memo, CLAZY_STRING, capacity, thread_safe);
+}
+
+void fscl_lazy_memo_clear(clazy_memo *memo) {
+    memo_lock(memo);
+    for (size_t i = 0; i <= memo->mask; ++i) {
+        if (memo->entries[i].used) {
+            memo_release(memo, &memo->entries[i]);
+        }
+    }
+    memo->count = 0;
+    memo->hand = 0;
+    memo_unlock(memo);
+}
+
+void fscl_lazy_memo_erase(clazy_memo *memo) {
+    if (memo->entries != NULL) {
+        fscl_lazy_memo_clear(memo);
+        fscl_free(memo->allocator, memo->entries, (memo->mask + 1) * sizeof(clazy_memo_entry));
+        memo->entries = NULL;
+    }
+    if (memo->lock != NULL) {
+        fscl_mutex_destroy((fscl_mutex_t *)memo->lock);
+        fscl_free(memo->allocator, memo->lock, sizeof(fscl_mutex_t));
+        memo->lock = NULL;
+    }
+}
+
+int fscl_lazy_memo_apply_int(clazy_memo *memo, int input) {
+    size_t hash = memo_hash_int(input);
+
+    memo_lock(memo);
+    size_t i = memo_find(memo, input, NULL, hash);
+    if (memo->entries[i].used) {
+        memo->entries[i].referenced = 1;
+        memo->hits++;
+        int value = memo->entries[i].value.int_value;
+        memo_unlock(memo);
+        return value;
+    }
+    memo->misses++;
+    memo_unlock(memo);
+
+    // Run the function unlocked so a slow miss does not serialize hits
+    int value = memo->function.map_int(input);
+
+    memo_lock(memo);
+    memo_insert(memo, input, NULL, hash, value, NULL);
+    memo_unlock(memo);
+    return value;
+}
+
+void fscl_lazy_memo_map_int(clazy_memo *memo, clazy *lazy) {
+    fscl_lazy_force(lazy);
+    fscl_lazy_set_int(lazy, fscl_lazy_memo_apply_int(memo, lazy->data.int_value));
+}
+
+void fscl_lazy_memo_map_cstring(clazy_memo *memo, clazy *lazy) {
+    fscl_lazy_force(lazy);
+    const char *input = lazy->data.string_value.data;
+    if (input == NULL) {
+        fscl_lazy_map_cstring(lazy, memo->function.map_cstring);
+        return;
+    }
+
+    size_t hash = memo_hash_cstring(input);
+
+    memo_lock(memo);
+    size_t i = memo_find(memo, 0, input, hash);
+    if (memo->entries[i].used) {
+        memo->entries[i].referenced = 1;
+        memo->hits++;
+        fscl_lazy_set_cstring(lazy, memo->entries[i].value.string_value);
+        memo_unlock(memo);
+        return;
+    }
+    memo->misses++;
+    memo_unlock(memo);
+
+    const char *result = memo->function.map_cstring(input);
+    if (result == NULL) {
+        fscl_lazy_erase(lazy);
+        lazy->data.string_value.data = NULL;
+        lazy->cache.memoized_string = lazy->data.string_value;
+        lazy->is_evaluated = 1;
+        return;
+    }
+
+    memo_lock(memo);
+    clazy_memo_entry *entry = memo_insert(memo, 0, input, hash, 0, result);
+    // The result may alias the input, so only copy from the memo's own storage
+    if (entry != NULL) {
+        fscl_lazy_set_cstring(lazy, entry->value.string_value);
+    } else if (result != input) {
+        fscl_lazy_set_cstring(lazy, result);
+    }
+    memo_unlock(memo);
+}
+
+clazy_memo_stats fscl_lazy_memo_stats(clazy_memo *memo) {
+    clazy_memo_stats stats;
+    memo_lock(memo);
+    stats.hits = memo->hits;
+    stats.misses = memo->misses;
+    stats.evictions = memo->evictions;
+    stats.size = memo->count;
+    stats.capacity = memo->capacity;
+    memo_unlock(memo);
+    return stats;
+}
@@ -0,0 +1,606 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#define _POSIX_C_SOURCE 200809L
+#define _DARWIN_C_SOURCE
+#include "fossil/xpattern/lazy_reduce.h"
+#include "fossil/xpattern/lazy_future.h"
+#include "xthread.h"
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REDUCE_BLOCK 256      // Values gathered before running a numeric kernel
+#define REDUCE_MIN_CHUNK 64   // Smallest unit of work handed to a participant
+#define REDUCE_ALIGN(n) (((n) + 15) & ~(size_t)15)
+
+// Either a lazy array (forced in place) or a lazy stream (produced per index)
+typedef struct {
+    clazy *items;
+    const clazy_stream *stream;
+} reduce_source;
+
+typedef struct {
+    size_t size;
+    void (*init)(void *accumulator, const void *arg);
+    void (*run)(void *accumulator, const reduce_source *source, size_t begin, size_t end, const void *arg);
+    void (*combine)(void *accumulator, const void *partial, const void *arg);
+} reduce_ops;
+
+static clazy *source_item(const reduce_source *source, size_t index, clazy *scratch) {
+    if (source->items != NULL) {
+        fscl_lazy_force(&source->items[index]);
+        return &source->items[index];
+    }
+    *scratch = fscl_lazy_stream_force(source->stream, index);
+    return scratch;
+}
+
+static void source_release(const reduce_source *source, clazy *item) {
+    if (source->items == NULL) {
+        fscl_lazy_erase(item);
+    }
+}
+
+// =================================================================
+// Parallel driver
+// =================================================================
+
+typedef struct {
+    const reduce_ops *ops;
+    const void *arg;
+    size_t size;             // Accumulator size, readable after the caller returns
+    reduce_source source;
+    size_t count;
+    size_t chunk;
+    size_t chunks;
+    atomic_size_t next;
+    fscl_mutex_t lock;
+    fscl_cond_t finished;
+    size_t chunks_done;
+    size_t refs;
+    unsigned char *total;
+    unsigned char *partial;  // The calling thread's accumulator
+} reduce_job;
+
+static void reduce_release(reduce_job *job) {
+    fscl_mutex_lock(&job->lock);
+    bool last = --job->refs == 0;
+    fscl_mutex_unlock(&job->lock);
+    if (last) {
+        fscl_cond_destroy(&job->finished);
+        fscl_mutex_destroy(&job->lock);
+        free(job);
+    }
+}
+
+// Claim chunks until none are left, then fold the private partial into the total.
+// ops and arg live on the caller's stack, so a helper that claims nothing must
+// not touch them: the caller may already have returned.
+static void reduce_participate(reduce_job *job, void *partial) {
+    size_t claimed = 0;
+    for (;;) {
+        size_t index = atomic_fetch_add(&job->next, 1);
+        if (index >= job->chunks) {
+            break;
+        }
+        if (claimed == 0) {
+            job->ops->init(partial, job->arg);
+        }
+        size_t begin = index * job->chunk;
+        size_t end = begin + job->chunk < job->count ? begin + job->chunk : job->count;
+        job->ops->run(partial, &job->source, begin, end, job->arg);
+        claimed++;
+    }
+
+    if (claimed > 0) {
+        fscl_mutex_lock(&job->lock);
+        job->ops->combine(job->total, partial, job->arg);
+        job->chunks_done += claimed;
+        if (job->chunks_done == job->chunks) {
+            fscl_cond_broadcast(&job->finished);
+        }
+        fscl_mutex_unlock(&job->lock);
+    }
+}
+
+static void reduce_helper(void *arg) {
+    reduce_job *job = arg;
+    void *partial = malloc(job->size);
+    if (partial != NULL) {
+        reduce_participate(job, partial);
+        free(partial);
+    }
+    reduce_release(job);
+}
+
+static void reduce_execute(const reduce_ops *ops, const void *arg, reduce_source source, size_t count, void *result, size_t threads) {
+    if (threads == 0) {
+        threads = fscl_lazy_pool_start(0) ? fscl_lazy_pool_workers() + 1 : 1;
+    }
+
+    size_t chunk = count / (threads * 8);
+    if (chunk < REDUCE_MIN_CHUNK) {
+        chunk = REDUCE_MIN_CHUNK;
+    }
+    size_t chunks = (count + chunk - 1) / chunk;
+
+    reduce_job *job = NULL;
+    if (threads > 1 && chunks > 1) {
+        size_t header = REDUCE_ALIGN(sizeof(reduce_job));
+        job = malloc(header + 2 * REDUCE_ALIGN(ops->size));
+    }
+    if (job == NULL) {
+        ops->init(result, arg);
+        ops->run(result, &source, 0, count, arg);
+        return;
+    }
+
+    job->ops = ops;
+    job->arg = arg;
+    job->size = ops->size;
+    job->source = source;
+    job->count = count;
+    job->chunk = chunk;
+    job->chunks = chunks;
+    atomic_init(&job->next, 0);
+    fscl_mutex_init(&job->lock);
+    fscl_cond_init(&job->finished);
+    job->chunks_done = 0;
+    job->total = (unsigned char *)job + REDUCE_ALIGN(sizeof(reduce_job));
+    job->partial = job->total + REDUCE_ALIGN(ops->size);
+    ops->init(job->total, arg);
+
+    size_t helpers = threads - 1 < chunks - 1 ? threads - 1 : chunks - 1;
+    job->refs = 1 + helpers;
+    for (size_t i = 0; i < helpers; ++i) {
+        if (!fscl_lazy_pool_submit(reduce_helper, job)) {
+            fscl_mutex_lock(&job->lock);
+            job->refs--;
+            fscl_mutex_unlock(&job->lock);
+        }
+    }
+
+    // The caller works too and only waits for chunks someone already claimed,
+    // so a reduction started from a pool worker cannot deadlock the pool
+    reduce_participate(job, job->partial);
+
+    fscl_mutex_lock(&job->lock);
+    while (job->chunks_done < job->chunks) {
+        fscl_cond_wait(&job->finished, &job->lock);
+    }
+    memcpy(result, job->total, ops->size);
+    fscl_mutex_unlock(&job->lock);
+    reduce_release(job);
+}
+
+// =================================================================
+// Built-in integer kernels
+// =================================================================
+
+typedef enum {
+    REDUCE_SUM,
+    REDUCE_MIN,
+    REDUCE_MAX
+} reduce_int_op;
+
+typedef struct {
+    long long sum;
+    int min;
+    int max;
+    size_t count;
+} reduce_int_acc;
+
+// =================================================================
+// Numeric kernels
+// =================================================================
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define REDUCE_HAVE_X86 1
+#define REDUCE_HAVE_AVX2 1
+#define REDUCE_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_M_X64)
+#include <emmintrin.h>
+#define REDUCE_HAVE_X86 1
+#define REDUCE_TARGET(isa)
+#endif
+
+enum { REDUCE_SCALAR, REDUCE_SSE2, REDUCE_AVX2 };
+
+static int reduce_detect(void) {
+#if defined(REDUCE_HAVE_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return REDUCE_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return REDUCE_SSE2;
+    }
+#elif defined(REDUCE_HAVE_X86)
+    return REDUCE_SSE2;
+#endif
+    return REDUCE_SCALAR;
+}
+
+static int reduce_level(void) {
+    static atomic_int cached = -1;
+    int level = atomic_load_explicit(&cached, memory_order_relaxed);
+    if (level < 0) {
+        level = reduce_detect();
+        atomic_store_explicit(&cached, level, memory_order_relaxed);
+    }
+    return level;
+}
+
+// Portable kernels with independent accumulators, also used for the tails
+static long long reduce_sum_scalar(const int *values, size_t n) {
+    long long a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        a0 += values[i];
+        a1 += values[i + 1];
+        a2 += values[i + 2];
+        a3 += values[i + 3];
+    }
+    for (; i < n; ++i) {
+        a0 += values[i];
+    }
+    return a0 + a1 + a2 + a3;
+}
+
+static int reduce_min_scalar(const int *values, size_t n, int current) {
+    int m0 = current, m1 = current;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        m0 = values[i] < m0 ? values[i] : m0;
+        m1 = values[i + 1] < m1 ? values[i + 1] : m1;
+    }
+    for (; i < n; ++i) {
+        m0 = values[i] < m0 ? values[i] : m0;
+    }
+    return m0 < m1 ? m0 : m1;
+}
+
+static int reduce_max_scalar(const int *values, size_t n, int current) {
+    int m0 = current, m1 = current;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        m0 = values[i] > m0 ? values[i] : m0;
+        m1 = values[i + 1] > m1 ? values[i + 1] : m1;
+    }
+    for (; i < n; ++i) {
+        m0 = values[i] > m0 ? values[i] : m0;
+    }
+    return m0 > m1 ? m0 : m1;
+}
+
+#if defined(REDUCE_HAVE_X86)
+REDUCE_TARGET("sse2") static long long reduce_sum_sse2(const int *values, size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // SSE2 has no 32 to 64-bit sign extension: pair each lane with its sign
+        __m128i v = _mm_loadu_si128((const __m128i *)(values + i));
+        __m128i sign = _mm_srai_epi32(v, 31);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+    }
+    long long lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    return lanes[0] + lanes[1] + reduce_sum_scalar(values + i, n - i);
+}
+
+// SSE2 has no 32-bit min/max either: blend through a compare mask
+REDUCE_TARGET("sse2") static int reduce_min_sse2(const int *values, size_t n, int current) {
+    __m128i m = _mm_set1_epi32(current);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(values + i));
+        __m128i less = _mm_cmplt_epi32(v, m);
+        m = _mm_or_si128(_mm_and_si128(less, v), _mm_andnot_si128(less, m));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, m);
+    return reduce_min_scalar(lanes, 4, reduce_min_scalar(values + i, n - i, current));
+}
+
+REDUCE_TARGET("sse2") static int reduce_max_sse2(const int *values, size_t n, int current) {
+    __m128i m = _mm_set1_epi32(current);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(values + i));
+        __m128i greater = _mm_cmpgt_epi32(v, m);
+        m = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, m));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, m);
+    return reduce_max_scalar(lanes, 4, reduce_max_scalar(values + i, n - i, current));
+}
+
+#if defined(REDUCE_HAVE_AVX2)
+REDUCE_TARGET("avx2") static long long reduce_sum_avx2(const int *values, size_t n) {
+    __m256i a0 = _mm256_setzero_si256();
+    __m256i a1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a0 = _mm256_add_epi64(a0, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(values + i))));
+        a1 = _mm256_add_epi64(a1, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(values + i + 4))));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(a0, a1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + reduce_sum_scalar(values + i, n - i);
+}
+
+REDUCE_TARGET("avx2") static int reduce_min_avx2(const int *values, size_t n, int current) {
+    __m256i m = _mm256_set1_epi32(current);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        m = _mm256_min_epi32(m, _mm256_loadu_si256((const __m256i *)(values + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, m);
+    return reduce_min_scalar(lanes, 8, reduce_min_scalar(values + i, n - i, current));
+}
+
+REDUCE_TARGET("avx2") static int reduce_max_avx2(const int *values, size_t n, int current) {
+    __m256i m = _mm256_set1_epi32(current);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        m = _mm256_max_epi32(m, _mm256_loadu_si256((const __m256i *)(values + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, m);
+    return reduce_max_scalar(lanes, 8, reduce_max_scalar(values + i, n - i, current));
+}
+#endif
+#endif
+
+static long long reduce_sum_block(int level, const int *values, size_t n) {
+    switch (level) {
+#if defined(REDUCE_HAVE_AVX2)
+        case REDUCE_AVX2:
+            return reduce_sum_avx2(values, n);
+#endif
+#if defined(REDUCE_HAVE_X86)
+        case REDUCE_SSE2:
+            return reduce_sum_sse2(values, n);
+#endif
+        default:
+            return reduce_sum_scalar(values, n);
+    }
+}
+
+static int reduce_min_block(int level, const int *values, size_t n, int current) {
+    switch (level) {
+#if defined(REDUCE_HAVE_AVX2)
+        case REDUCE_AVX2:
+            return reduce_min_avx2(values, n, current);
+#endif
+#if defined(REDUCE_HAVE_X86)
+        case REDUCE_SSE2:
+            return reduce_min_sse2(values, n, current);
+#endif
+        default:
+            return reduce_min_scalar(values, n, current);
+    }
+}
+
+static int reduce_max_block(int level, const int *values, size_t n, int current) {
+    switch (level) {
+#if defined(REDUCE_HAVE_AVX2)
+        case REDUCE_AVX2:
+            return reduce_max_avx2(values, n, current);
+#endif
+#if defined(REDUCE_HAVE_X86)
+        case REDUCE_SSE2:
+            return reduce_max_sse2(values, n, current);
+#endif
+        default:
+            return reduce_max_scalar(values, n, current);
+    }
+}
+
+static void reduce_int_init(void *accumulator, const void *arg) {
+    (void)arg;
+    reduce_int_acc *acc = accumulator;
+    acc->sum = 0;
+    acc->min = INT_MAX;
+    acc->max = INT_MIN;
+    acc->count = 0;
+}
+
+static void reduce_int_run(void *accumulator, const reduce_source *source, size_t begin, size_t end, const void *arg) {
+    reduce_int_acc *acc = accumulator;
+    reduce_int_op op = *(const reduce_int_op *)arg;
+    int level = reduce_level();
+    int block[REDUCE_BLOCK];
+
+    while (begin < end) {
+        size_t n = end - begin < REDUCE_BLOCK ? end - begin : REDUCE_BLOCK;
+        if (source->items != NULL) {
+            // Evaluated array items are read straight from their cache
+            for (size_t i = 0; i < n; ++i) {
+                clazy *item = &source->items[begin + i];
+                if (item->future != NULL || !item->is_evaluated) {
+                    fscl_lazy_force(item);
+                }
+                block[i] = item->cache.memoized_int;
+            }
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                clazy scratch;
+                clazy *item = source_item(source, begin + i, &scratch);
+                block[i] = item->cache.memoized_int;
+                source_release(source, item);
+            }
+        }
+        switch (op) {
+            case REDUCE_SUM:
+                acc->sum += reduce_sum_block(level, block, n);
+                break;
+            case REDUCE_MIN:
+                acc->min = reduce_min_block(level, block, n, acc->min);
+                break;
+            case REDUCE_MAX:
+                acc->max = reduce_max_block(level, block, n, acc->max);
+                break;
+        }
+        acc->count += n;
+        begin += n;
+    }
+}
+
+static void reduce_int_combine(void *accumulator, const void *partial, const void *arg) {
+    (void)arg;
+    reduce_int_acc *acc = accumulator;
+    const reduce_int_acc *part = partial;
+    acc->sum += part->sum;
+    acc->min = part->min < acc->min ? part->min : acc->min;
+    acc->max = part->max > acc->max ? part->max : acc->max;
+    acc->count += part->count;
+}
+
+static const reduce_ops reduce_int_ops = { sizeof(reduce_int_acc), reduce_int_init, reduce_int_run, reduce_int_combine };
+
+static reduce_int_acc reduce_int(reduce_source source, size_t count, reduce_int_op op, size_t threads) {
+    reduce_int_acc acc;
+    reduce_execute(&reduce_int_ops, &op, source, count, &acc, threads);
+    return acc;
+}
+
+// =================================================================
+// count_if and user folds
+// =================================================================
+
+typedef struct {
+    bool (*predicate)(clazy *item);
+} reduce_count_arg;
+
+static void reduce_count_init(void *accumulator, const void *arg) {
+    (void)arg;
+    *(size_t *)accumulator = 0;
+}
+
+static void reduce_count_run(void *accumulator, const reduce_source *source, size_t begin, size_t end, const void *arg) {
+    const reduce_count_arg *count_arg = arg;
+    size_t matches = 0;
+    for (size_t i = begin; i < end; ++i) {
+        clazy scratch;
+        clazy *item = source_item(source, i, &scratch);
+        matches += count_arg->predicate(item) ? 1 : 0;
+        source_release(source, item);
+    }
+    *(size_t *)accumulator += matches;
+}
+
+static void reduce_count_combine(void *accumulator, const void *partial, const void *arg) {
+    (void)arg;
+    *(size_t *)accumulator += *(const size_t *)partial;
+}
+
+static const reduce_ops reduce_count_ops = { sizeof(size_t), reduce_count_init, reduce_count_run, reduce_count_combine };
+
+static void reduce_fold_init(void *accumulator, const void *arg) {
+    const clazy_fold *fold = arg;
+    fold->init(accumulator, fold->context);
+}
+
+static void reduce_fold_run(void *accumulator, const reduce_source *source, size_t begin, size_t end, const void *arg) {
+    const clazy_fold *fold = arg;
+    for (size_t i = begin; i < end; ++i) {
+        clazy scratch;
+        clazy *item = source_item(source, i, &scratch);
+        fold->step(accumulator, item, fold->context);
+        source_release(source, item);
+    }
+}
+
+static void reduce_fold_combine(void *accumulator, const void *partial, const void *arg) {
+    const clazy_fold *fold = arg;
+    fold->combine(accumulator, partial, fold->context);
+}
+
+static void reduce_fold(reduce_source source, size_t count, const clazy_fold *fold, void *result, size_t threads) {
+    reduce_ops ops = { fold->size, reduce_fold_init, reduce_fold_run, reduce_fold_combine };
+    reduce_execute(&ops, fold, source, count, result, threads);
+}
+
+static size_t reduce_count(reduce_source source, size_t count, bool (*predicate)(clazy *item), size_t threads) {
+    reduce_count_arg arg = { predicate };
+    size_t matches;
+    reduce_execute(&reduce_count_ops, &arg, source, count, &matches, threads);
+    return matches;
+}
+
+// =================================================================
+// Public API
+// =================================================================
+
+static reduce_source array_source(clazy *items) {
+    reduce_source source = { items, NULL };
+    return source;
+}
+
+static reduce_source stream_source(const clazy_stream *stream) {
+    reduce_source source = { NULL, stream };
+    return source;
+}
+
+void fscl_lazy_fold(clazy *items, size_t count, const clazy_fold *fold, void *result, size_t threads) {
+    reduce_fold(array_source(items), count, fold, result, threads);
+}
+
+long long fscl_lazy_sum_int(clazy *items, size_t count, size_t threads) {
+    return reduce_int(array_source(items), count, REDUCE_SUM, threads).sum;
+}
+
+bool fscl_lazy_min_int(clazy *items, size_t count, size_t threads, int *result) {
+    reduce_int_acc acc = reduce_int(array_source(items), count, REDUCE_MIN, threads);
+    *result = acc.min;
+    return acc.count > 0;
+}
+
+bool fscl_lazy_max_int(clazy *items, size_t count, size_t threads, int *result) {
+    reduce_int_acc acc = reduce_int(array_source(items), count, REDUCE_MAX, threads);
+    *result = acc.max;
+    return acc.count > 0;
+}
+
+size_t fscl_lazy_count_if(clazy *items, size_t count, bool (*predicate)(clazy *item), size_t threads) {
+    return reduce_count(array_source(items), count, predicate, threads);
+}
+
+void fscl_lazy_stream_fold(const clazy_stream *stream, const clazy_fold *fold, void *result, size_t threads) {
+    reduce_fold(stream_source(stream), stream->length, fold, result, threads);
+}
+
+long long fscl_lazy_stream_sum_int(const clazy_stream *stream, size_t threads) {
+    return reduce_int(stream_source(stream), stream->length, REDUCE_SUM, threads).sum;
+}
+
+bool fscl_lazy_stream_min_int(const clazy_stream *stream, size_t threads, int *result) {
+    reduce_int_acc acc = reduce_int(stream_source(stream), stream->length, REDUCE_MIN, threads);
+    *result = acc.min;
+    return acc.count > 0;
+}
+
+bool fscl_lazy_stream_max_int(const clazy_stream *stream, size_t threads, int *result) {
+    reduce_int_acc acc = reduce_int(stream_source(stream), stream->length, REDUCE_MAX, threads);
+    *result = acc.max;
+    return acc.count > 0;
+}
+
+size_t fscl_lazy_stream_count_if(const clazy_stream *stream, bool (*predicate)(clazy *item), size_t threads) {
+    return reduce_count(stream_source(stream), stream->length, predicate, threads);
+}
@@ -0,0 +1,200 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#define _POSIX_C_SOURCE 200809L
+#define _DARWIN_C_SOURCE
+#include "fossil/xpattern/lazy_stream.h"
+#include "xthread.h"
+#include <stdatomic.h>
+
+#define PREFETCH_DEFAULT_DEPTH 16
+#define PREFETCH_SPINS 64
+
+// The consumer owns `head`, the producer owns `tail`; each sits on its own
+// cache line so the two threads do not bounce a shared line on every item.
+typedef struct {
+    atomic_size_t head;
+    char head_pad[64 - sizeof(atomic_size_t)];
+    atomic_size_t tail;
+    char tail_pad[64 - sizeof(atomic_size_t)];
+    atomic_bool done;
+    atomic_bool cancelled;
+    atomic_bool consumer_waiting;
+    atomic_bool producer_waiting;
+    fscl_mutex_t lock;
+    fscl_cond_t not_empty;
+    fscl_cond_t not_full;
+    fscl_thread_t thread;
+    bool threaded;
+    size_t mask;
+    size_t next_index;
+    clazy_stream stream;              // Producer's copy of the stream
+    const callocator *allocator;      // Owns this state
+    clazy slots[];
+} prefetch_state;
+
+#define PREFETCH_STATE(prefetch) ((prefetch_state *)(prefetch)->state)
+
+// Sleep until ready() holds. The waiting flag and the publisher's store are
+// both sequentially consistent, so either the waiter sees the new value or
+// the publisher sees the flag and signals under the lock.
+static void prefetch_wait(prefetch_state *state, atomic_bool *waiting, fscl_cond_t *cond,
+                          bool (*ready)(prefetch_state *)) {
+    for (int spin = 0; spin < PREFETCH_SPINS; ++spin) {
+        if (ready(state)) {
+            return;
+        }
+    }
+    fscl_mutex_lock(&state->lock);
+    atomic_store(waiting, true);
+    while (!ready(state)) {
+        fscl_cond_wait(cond, &state->lock);
+    }
+    atomic_store(waiting, false);
+    fscl_mutex_unlock(&state->lock);
+}
+
+static void prefetch_wake(prefetch_state *state, atomic_bool *waiting, fscl_cond_t *cond) {
+    if (atomic_load(waiting)) {
+        fscl_mutex_lock(&state->lock);
+        fscl_cond_signal(cond);
+        fscl_mutex_unlock(&state->lock);
+    }
+}
+
+static bool prefetch_has_room(prefetch_state *state) {
+    size_t tail = atomic_load_explicit(&state->tail, memory_order_relaxed);
+    return tail - atomic_load(&state->head) <= state->mask || atomic_load(&state->cancelled);
+}
+
+static bool prefetch_has_item(prefetch_state *state) {
+    return atomic_load(&state->tail) != atomic_load_explicit(&state->head, memory_order_relaxed) ||
+           atomic_load(&state->done) || atomic_load(&state->cancelled);
+}
+
+static void prefetch_produce(void *arg) {
+    prefetch_state *state = arg;
+
+    for (size_t index = 0; index < state->stream.length; ++index) {
+        prefetch_wait(state, &state->producer_waiting, &state->not_full, prefetch_has_room);
+        if (atomic_load_explicit(&state->cancelled, memory_order_relaxed)) {
+            break;
+        }
+        size_t tail = atomic_load_explicit(&state->tail, memory_order_relaxed);
+        state->slots[tail & state->mask] = fscl_lazy_stream_force(&state->stream, index);
+        atomic_store(&state->tail, tail + 1);
+        prefetch_wake(state, &state->consumer_waiting, &state->not_empty);
+    }
+
+    atomic_store(&state->done, true);
+    prefetch_wake(state, &state->consumer_waiting, &state->not_empty);
+}
+
+static size_t prefetch_round_up(size_t depth) {
+    size_t capacity = 1;
+    while (capacity < depth) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+bool fscl_lazy_prefetch_create(clazy_prefetch *prefetch, const clazy_stream *stream, size_t depth) {
+    size_t capacity = prefetch_round_up(depth ? depth : PREFETCH_DEFAULT_DEPTH);
+    prefetch->stream = *stream;
+    prefetch->depth = capacity;
+    prefetch->state = NULL;
+
+    const callocator *allocator = fscl_alloc_default();
+    prefetch_state *state = fscl_alloc(allocator, sizeof(prefetch_state) + capacity * sizeof(clazy));
+    if (state == NULL) {
+        return false;
+    }
+    state->allocator = allocator;
+    atomic_init(&state->head, 0);
+    atomic_init(&state->tail, 0);
+    atomic_init(&state->done, false);
+    atomic_init(&state->cancelled, false);
+    atomic_init(&state->consumer_waiting, false);
+    atomic_init(&state->producer_waiting, false);
+    fscl_mutex_init(&state->lock);
+    fscl_cond_init(&state->not_empty);
+    fscl_cond_init(&state->not_full);
+    state->mask = capacity - 1;
+    state->next_index = 0;
+    state->stream = *stream;
+    prefetch->state = state;
+
+    state->threaded = fscl_thread_create(&state->thread, prefetch_produce, state);
+    return true;
+}
+
+bool fscl_lazy_prefetch_next(clazy_prefetch *prefetch, clazy *out) {
+    prefetch_state *state = PREFETCH_STATE(prefetch);
+    if (state == NULL || atomic_load_explicit(&state->cancelled, memory_order_relaxed)) {
+        return false;
+    }
+
+    // No producer thread: generate on demand
+    if (!state->threaded) {
+        if (state->next_index >= prefetch->stream.length) {
+            return false;
+        }
+        *out = fscl_lazy_stream_force(&prefetch->stream, state->next_index++);
+        return true;
+    }
+
+    prefetch_wait(state, &state->consumer_waiting, &state->not_empty, prefetch_has_item);
+    size_t head = atomic_load_explicit(&state->head, memory_order_relaxed);
+    if (head == atomic_load(&state->tail) || atomic_load(&state->cancelled)) {
+        return false;
+    }
+
+    *out = state->slots[head & state->mask];
+    atomic_store(&state->head, head + 1);
+    prefetch_wake(state, &state->producer_waiting, &state->not_full);
+    return true;
+}
+
+void fscl_lazy_prefetch_cancel(clazy_prefetch *prefetch) {
+    prefetch_state *state = PREFETCH_STATE(prefetch);
+    if (state == NULL) {
+        return;
+    }
+    atomic_store(&state->cancelled, true);
+    fscl_mutex_lock(&state->lock);
+    fscl_cond_broadcast(&state->not_full);
+    fscl_cond_broadcast(&state->not_empty);
+    fscl_mutex_unlock(&state->lock);
+}
+
+void fscl_lazy_prefetch_erase(clazy_prefetch *prefetch) {
+    prefetch_state *state = PREFETCH_STATE(prefetch);
+    if (state == NULL) {
+        return;
+    }
+
+    fscl_lazy_prefetch_cancel(prefetch);
+    if (state->threaded) {
+        fscl_thread_join(state->thread);
+    }
+
+    size_t tail = atomic_load(&state->tail);
+    for (size_t head = atomic_load(&state->head); head != tail; ++head) {
+        fscl_lazy_erase(&state->slots[head & state->mask]);
+    }
+
+    fscl_cond_destroy(&state->not_full);
+    fscl_cond_destroy(&state->not_empty);
+    fscl_mutex_destroy(&state->lock);
+    fscl_free(state->allocator, state, sizeof(prefetch_state) + prefetch->depth * sizeof(clazy));
+    prefetch->state = NULL;
+}
@@ -10,19 +10,49 @@ Description:
     feel free to contact Michael at michaelbrockus@gmail.com.
 ==============================================================================
 */
+#ifndef FSCL_XPATTERN_INLINE
+#define FSCL_XPATTERN_INLINE
+#endif
 #include "fossil/xpattern/observer.h"
+#include "xtrace.h"
 #include <stdlib.h>
 #include <string.h>
 
+// Marks the base of a cpayload_observer; never called through the subject
+static void observe_lazy_tag(void* data) {
+    (void)data;
+}
+
+// Function to hand data to one observer, wrapping it for lazy observers
+static inline void observe_dispatch(csubject* subject, cobserver* observer, void* data) {
+    (void)subject; // Only read by the trace probes
+    if (observer->update == observe_lazy_tag) {
+        cpayload payload = { NULL, NULL, NULL, data, true };
+        FSCL_TRACE_OBSERVER_DISPATCH(subject, observer);
+        ((cpayload_observer*)observer)->update(&payload);
+    } else if (observer->update != NULL) {
+        FSCL_TRACE_OBSERVER_DISPATCH(subject, observer);
+        observer->update(data);
+    }
+}
+
 // Function to initialize a subject
 void fscl_observe_create(csubject* subject) {
+    fscl_observe_create_with(subject, fscl_alloc_default());
+}
+
+// Function to initialize a subject with its own allocator
+void fscl_observe_create_with(csubject* subject, const callocator* allocator) {
     subject->observers = NULL;
     subject->numObservers = 0;
+    subject->allocator = allocator;
 }
 
 // Function to add an observer to the subject
 void fscl_observe_add_observer(csubject* subject, cobserver* observer) {
-    cobserver** newObservers = (cobserver**)realloc(subject->observers, (subject->numObservers + 1) * sizeof(cobserver*));
+    cobserver** newObservers = (cobserver**)fscl_realloc(subject->allocator, subject->observers,
+                                                         subject->numObservers * sizeof(cobserver*),
+                                                         (subject->numObservers + 1) * sizeof(cobserver*));
     if (newObservers == NULL) {
         puts("Memory allocation error while attempting to add observer");
         return;
@@ -40,7 +70,14 @@ void fscl_observe_remove_observer(csubject* subject, cobserver* observer) {
                 subject->observers[j] = subject->observers[j + 1];
             }
 
-            cobserver** newObservers = (cobserver**)realloc(subject->observers, (subject->numObservers - 1) * sizeof(cobserver*));
+            size_t size = subject->numObservers * sizeof(cobserver*);
+            cobserver** newObservers = NULL;
+            if (subject->numObservers - 1 == 0) {
+                fscl_free(subject->allocator, subject->observers, size);
+            } else {
+                newObservers = (cobserver**)fscl_realloc(subject->allocator, subject->observers, size,
+                                                         size - sizeof(cobserver*));
+            }
             if (newObservers != NULL || subject->numObservers - 1 == 0) {
                 subject->observers = newObservers;
                 subject->numObservers--;
@@ -50,30 +87,71 @@ void fscl_observe_remove_observer(csubject* subject, cobserver* observer) {
     }
 }
 
+// Function to add an observer of deferred payloads to the subject
+void fscl_observe_add_lazy_observer(csubject* subject, cpayload_observer* observer) {
+    observer->base.update = observe_lazy_tag;
+    fscl_observe_add_observer(subject, &observer->base);
+}
+
+// Function to remove an observer of deferred payloads from the subject
+void fscl_observe_remove_lazy_observer(csubject* subject, cpayload_observer* observer) {
+    fscl_observe_remove_observer(subject, &observer->base);
+}
+
 // Function to notify all observers of an event
 void fscl_observe_notify(csubject* subject, void* data) {
+    FSCL_TRACE_NOTIFY_BEGIN(subject, subject->numObservers);
     for (int i = 0; i < subject->numObservers; ++i) {
-        if (subject->observers[i]->update != NULL) {
-            subject->observers[i]->update(data);
+        observe_dispatch(subject, subject->observers[i], data);
+    }
+    FSCL_TRACE_NOTIFY_END(subject, subject->numObservers);
+}
+
+// Function to notify all observers with a payload built on first use
+void fscl_observe_notify_lazy(csubject* subject, void* (*build)(void* context),
+                              void (*destroy)(void* payload, void* context), void* context) {
+    cpayload payload = { build, destroy, context, NULL, false };
+
+    FSCL_TRACE_NOTIFY_BEGIN(subject, subject->numObservers);
+    for (int i = 0; i < subject->numObservers; ++i) {
+        cobserver* observer = subject->observers[i];
+        if (observer->update == observe_lazy_tag) {
+            FSCL_TRACE_OBSERVER_DISPATCH(subject, observer);
+            ((cpayload_observer*)observer)->update(&payload);
+        } else if (observer->update != NULL) {
+            FSCL_TRACE_OBSERVER_DISPATCH(subject, observer);
+            observer->update(fscl_observe_payload_get(&payload));
         }
     }
+    FSCL_TRACE_NOTIFY_END(subject, subject->numObservers);
+
+    if (payload.built && destroy != NULL) {
+        destroy(payload.value, context);
+    }
+}
+
+// Function to build a deferred payload once and share it afterwards
+void* fscl_observe_payload_get(cpayload* payload) {
+    if (!payload->built) {
+        payload->value = payload->build(payload->context);
+        payload->built = true;
+    }
+    return payload->value;
 }
 
 // Function to clear all observers
 void fscl_observe_erase_all(csubject* subject) {
-    free(subject->observers);
+    fscl_free(subject->allocator, subject->observers, subject->numObservers * sizeof(cobserver*));
     subject->observers = NULL;
     subject->numObservers = 0;
 }
 
-// Function to check if the subject has observers
-int fscl_observe_has_observers(csubject* subject) {
-    return subject->numObservers > 0;
-}
+// Function to check if the subject has observers (inline in observer.h)
+extern inline int fscl_observe_has_observers(csubject* subject);
 
 // Function to perform subject cleanup
 void fscl_observe_erase(csubject* subject) {
-    free(subject->observers);
+    fscl_free(subject->allocator, subject->observers, subject->numObservers * sizeof(cobserver*));
     subject->observers = NULL;
     subject->numObservers = 0;
     // Additional cleanup steps, if needed
@@ -81,9 +159,9 @@ void fscl_observe_erase(csubject* subject) {
 
 // Function to update all observers with data
 void fscl_observe_update_all(csubject* subject, void* data) {
+    FSCL_TRACE_NOTIFY_BEGIN(subject, subject->numObservers);
     for (int i = 0; i < subject->numObservers; ++i) {
-        if (subject->observers[i]->update != NULL) {
-            subject->observers[i]->update(data);
-        }
+        observe_dispatch(subject, subject->observers[i], data);
     }
+    FSCL_TRACE_NOTIFY_END(subject, subject->numObservers);
 }
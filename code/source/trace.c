@@ -0,0 +1,241 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#define _POSIX_C_SOURCE 200809L
+#define _DARWIN_C_SOURCE
+#include "xtrace.h"
+#include "xthread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (FSCL_TRACE_RING_SIZE & (FSCL_TRACE_RING_SIZE - 1)) != 0
+#error "FSCL_TRACE_RING_SIZE must be a power of two"
+#endif
+
+#define TRACE_MAGIC "FTRC"
+#define TRACE_VERSION 1
+
+// Fields are relaxed atomics so a snapshot can read a ring while its owner
+// keeps writing; torn slots are detected through the head and discarded
+typedef struct {
+    atomic_uint_least64_t time_ns;
+    atomic_uint_least64_t tag;  // thread << 32 | event
+    atomic_uint_least64_t arg0;
+    atomic_uint_least64_t arg1;
+} trace_slot;
+
+// Single-writer ring of one thread. Rings are never freed: when their
+// thread exits they are handed to the next thread that starts tracing.
+typedef struct trace_ring {
+    struct trace_ring *next;
+    atomic_ullong head;   // Records ever written
+    atomic_ullong floor;  // Records below this index were cleared
+    atomic_bool abandoned;
+    uint32_t thread;
+    trace_slot slots[FSCL_TRACE_RING_SIZE];
+} trace_ring;
+
+typedef struct {
+    ctrace_record record;
+    unsigned long long sequence;
+} trace_entry;
+
+atomic_bool fscl_trace_active = true;
+
+static struct {
+    fscl_mutex_t lock;
+    atomic_bool key_ready;
+    fscl_tls_t key;
+    trace_ring *rings;
+    uint32_t threads;
+} tracer = { .lock = FSCL_MUTEX_INITIALIZER };
+
+static void trace_abandon(void *value) {
+    trace_ring *ring = value;
+    atomic_store_explicit(&ring->abandoned, true, memory_order_release);
+}
+
+static trace_ring *trace_attach(void) {
+    fscl_mutex_lock(&tracer.lock);
+    if (!atomic_load_explicit(&tracer.key_ready, memory_order_relaxed)) {
+        if (!fscl_tls_create(&tracer.key, trace_abandon)) {
+            fscl_mutex_unlock(&tracer.lock);
+            return NULL;
+        }
+        atomic_store_explicit(&tracer.key_ready, true, memory_order_release);
+    }
+
+    trace_ring *ring = tracer.rings;
+    while (ring != NULL && !atomic_load_explicit(&ring->abandoned, memory_order_acquire)) {
+        ring = ring->next;
+    }
+    if (ring == NULL) {
+        ring = malloc(sizeof(trace_ring));
+        if (ring == NULL) {
+            fscl_mutex_unlock(&tracer.lock);
+            return NULL;
+        }
+        memset(ring->slots, 0, sizeof(ring->slots));
+        atomic_init(&ring->head, 0);
+        atomic_init(&ring->floor, 0);
+        ring->next = tracer.rings;
+        tracer.rings = ring;
+    }
+    atomic_store_explicit(&ring->abandoned, false, memory_order_relaxed);
+    ring->thread = ++tracer.threads;
+    fscl_mutex_unlock(&tracer.lock);
+
+    fscl_tls_set(tracer.key, ring);
+    return ring;
+}
+
+int fscl_trace_mode(void) {
+    return FSCL_TRACE;
+}
+
+void fscl_trace_enable(bool enabled) {
+    atomic_store_explicit(&fscl_trace_active, enabled, memory_order_relaxed);
+}
+
+void fscl_trace_record(uint32_t event, uint64_t arg0, uint64_t arg1) {
+    if (!atomic_load_explicit(&fscl_trace_active, memory_order_relaxed)) {
+        return;
+    }
+    trace_ring *ring = NULL;
+    if (atomic_load_explicit(&tracer.key_ready, memory_order_acquire)) {
+        ring = fscl_tls_get(tracer.key);
+    }
+    if (ring == NULL && (ring = trace_attach()) == NULL) {
+        return;
+    }
+
+    unsigned long long head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    trace_slot *slot = &ring->slots[head & (FSCL_TRACE_RING_SIZE - 1)];
+    atomic_store_explicit(&slot->time_ns, fscl_time_ns(), memory_order_relaxed);
+    atomic_store_explicit(&slot->tag, (uint64_t)ring->thread << 32 | event, memory_order_relaxed);
+    atomic_store_explicit(&slot->arg0, arg0, memory_order_relaxed);
+    atomic_store_explicit(&slot->arg1, arg1, memory_order_relaxed);
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+// Copy the intact records of one ring; the slot being written is never trusted
+static size_t trace_collect_ring(trace_ring *ring, trace_entry *out, size_t capacity) {
+    unsigned long long head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    unsigned long long start = atomic_load_explicit(&ring->floor, memory_order_relaxed);
+    if (head - start > FSCL_TRACE_RING_SIZE - 1) {
+        start = head - (FSCL_TRACE_RING_SIZE - 1);
+    }
+
+    size_t count = 0;
+    for (unsigned long long index = start; index < head && count < capacity; ++index) {
+        trace_slot *slot = &ring->slots[index & (FSCL_TRACE_RING_SIZE - 1)];
+        uint64_t tag = atomic_load_explicit(&slot->tag, memory_order_relaxed);
+        out[count].record.time_ns = atomic_load_explicit(&slot->time_ns, memory_order_relaxed);
+        out[count].record.thread = (uint32_t)(tag >> 32);
+        out[count].record.event = (uint32_t)tag;
+        out[count].record.arg0 = atomic_load_explicit(&slot->arg0, memory_order_relaxed);
+        out[count].record.arg1 = atomic_load_explicit(&slot->arg1, memory_order_relaxed);
+        out[count].sequence = index;
+        count++;
+    }
+
+    // Drop whatever the writer may have overwritten while we copied
+    atomic_thread_fence(memory_order_acquire);
+    unsigned long long now = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    unsigned long long safe = now >= FSCL_TRACE_RING_SIZE - 1 ? now - (FSCL_TRACE_RING_SIZE - 1) : 0;
+    size_t skip = 0;
+    while (skip < count && out[skip].sequence < safe) {
+        skip++;
+    }
+    memmove(out, out + skip, (count - skip) * sizeof(trace_entry));
+    return count - skip;
+}
+
+static int trace_compare(const void *a, const void *b) {
+    const trace_entry *x = a;
+    const trace_entry *y = b;
+    if (x->record.time_ns != y->record.time_ns) {
+        return x->record.time_ns < y->record.time_ns ? -1 : 1;
+    }
+    if (x->record.thread != y->record.thread) {
+        return x->record.thread < y->record.thread ? -1 : 1;
+    }
+    return (x->sequence > y->sequence) - (x->sequence < y->sequence);
+}
+
+// Gather the records of every ring into one time-ordered array
+static trace_entry *trace_collect(size_t *count) {
+    fscl_mutex_lock(&tracer.lock);
+    size_t rings = 0;
+    for (trace_ring *ring = tracer.rings; ring != NULL; ring = ring->next) {
+        rings++;
+    }
+    trace_entry *entries = malloc((rings ? rings : 1) * FSCL_TRACE_RING_SIZE * sizeof(trace_entry));
+    size_t total = 0;
+    if (entries != NULL) {
+        for (trace_ring *ring = tracer.rings; ring != NULL; ring = ring->next) {
+            total += trace_collect_ring(ring, entries + total, FSCL_TRACE_RING_SIZE);
+        }
+    }
+    fscl_mutex_unlock(&tracer.lock);
+
+    if (entries != NULL) {
+        qsort(entries, total, sizeof(trace_entry), trace_compare);
+    }
+    *count = total;
+    return entries;
+}
+
+size_t fscl_trace_snapshot(ctrace_record *records, size_t capacity) {
+    size_t total = 0;
+    trace_entry *entries = trace_collect(&total);
+    if (entries == NULL) {
+        return 0;
+    }
+    size_t first = total > capacity ? total - capacity : 0;
+    for (size_t i = first; i < total; ++i) {
+        records[i - first] = entries[i].record;
+    }
+    free(entries);
+    return total - first;
+}
+
+bool fscl_trace_dump(const char *path) {
+    size_t total = 0;
+    trace_entry *entries = trace_collect(&total);
+    if (entries == NULL) {
+        return false;
+    }
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        free(entries);
+        return false;
+    }
+
+    uint32_t header[3] = { TRACE_VERSION, (uint32_t)sizeof(ctrace_record), (uint32_t)total };
+    bool written = fwrite(TRACE_MAGIC, 1, 4, file) == 4 && fwrite(header, sizeof(header), 1, file) == 1;
+    for (size_t i = 0; i < total && written; ++i) {
+        written = fwrite(&entries[i].record, sizeof(ctrace_record), 1, file) == 1;
+    }
+    free(entries);
+    return fclose(file) == 0 && written;
+}
+
+void fscl_trace_clear(void) {
+    fscl_mutex_lock(&tracer.lock);
+    for (trace_ring *ring = tracer.rings; ring != NULL; ring = ring->next) {
+        atomic_store_explicit(&ring->floor, atomic_load_explicit(&ring->head, memory_order_acquire),
+                              memory_order_relaxed);
+    }
+    fscl_mutex_unlock(&tracer.lock);
+}
@@ -0,0 +1,36 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+// Amalgamated build: the whole library as one translation unit, so the
+// compiler can inline and specialize across modules without LTO. Build it
+// on its own (meson -Dsingle_tu=true does) or drop it into another project
+// with code/include and code/source on the include path. Keep the list in
+// step with code/source/meson.build.
+#define _POSIX_C_SOURCE 200809L
+#define _DARWIN_C_SOURCE
+#define FSCL_XPATTERN_INLINE
+
+#include "alloc.c"
+#include "lazy.c"
+#include "lazy_memo.c"
+#include "lazy_future.c"
+#include "lazy_expire.c"
+#include "lazy_reduce.c"
+#include "lazy_format.c"
+#include "lazy_stream.c"
+#include "observer.c"
+#include "contract.c"
+#include "contract_report.c"
+#include "contract_sample.c"
+#include "contract_span.c"
+#include "contract_set.c"
+#include "trace.c"
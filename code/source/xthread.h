@@ -0,0 +1,176 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_XTHREAD_H
+#define FSCL_XTHREAD_H
+
+// Internal threading shims shared by the library sources. Not installed.
+// Sources that use the POSIX side define _POSIX_C_SOURCE before any include.
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+
+typedef SRWLOCK fscl_mutex_t;
+typedef CONDITION_VARIABLE fscl_cond_t;
+typedef HANDLE fscl_thread_t;
+typedef DWORD fscl_tls_t;
+
+#define FSCL_MUTEX_INITIALIZER SRWLOCK_INIT
+#define FSCL_COND_INITIALIZER CONDITION_VARIABLE_INIT
+
+static inline void fscl_mutex_init(fscl_mutex_t* mutex) { InitializeSRWLock(mutex); }
+static inline void fscl_mutex_destroy(fscl_mutex_t* mutex) { (void)mutex; }
+static inline void fscl_mutex_lock(fscl_mutex_t* mutex) { AcquireSRWLockExclusive(mutex); }
+static inline void fscl_mutex_unlock(fscl_mutex_t* mutex) { ReleaseSRWLockExclusive(mutex); }
+
+static inline void fscl_cond_init(fscl_cond_t* cond) { InitializeConditionVariable(cond); }
+static inline void fscl_cond_destroy(fscl_cond_t* cond) { (void)cond; }
+static inline void fscl_cond_wait(fscl_cond_t* cond, fscl_mutex_t* mutex) { SleepConditionVariableSRW(cond, mutex, INFINITE, 0); }
+static inline void fscl_cond_signal(fscl_cond_t* cond) { WakeConditionVariable(cond); }
+static inline void fscl_cond_broadcast(fscl_cond_t* cond) { WakeAllConditionVariable(cond); }
+static inline void fscl_cond_timedwait_ms(fscl_cond_t* cond, fscl_mutex_t* mutex, unsigned long ms) {
+    SleepConditionVariableSRW(cond, mutex, ms, 0);
+}
+
+// Fiber-local storage runs the destructor on thread exit, like pthread keys
+static inline bool fscl_tls_create(fscl_tls_t* key, void (*destructor)(void* value)) {
+    *key = FlsAlloc((PFLS_CALLBACK_FUNCTION)destructor);
+    return *key != FLS_OUT_OF_INDEXES;
+}
+static inline void* fscl_tls_get(fscl_tls_t key) { return FlsGetValue(key); }
+static inline void fscl_tls_set(fscl_tls_t key, void* value) { FlsSetValue(key, value); }
+
+static inline size_t fscl_cpu_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+}
+
+static inline unsigned long long fscl_time_ns(void) {
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (unsigned long long)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+}
+#else
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#error "define _POSIX_C_SOURCE 200809L before any include in sources that use xthread.h"
+#endif
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef pthread_mutex_t fscl_mutex_t;
+typedef pthread_cond_t fscl_cond_t;
+typedef pthread_t fscl_thread_t;
+typedef pthread_key_t fscl_tls_t;
+
+#define FSCL_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#define FSCL_COND_INITIALIZER PTHREAD_COND_INITIALIZER
+
+static inline void fscl_mutex_init(fscl_mutex_t* mutex) { pthread_mutex_init(mutex, NULL); }
+static inline void fscl_mutex_destroy(fscl_mutex_t* mutex) { pthread_mutex_destroy(mutex); }
+static inline void fscl_mutex_lock(fscl_mutex_t* mutex) { pthread_mutex_lock(mutex); }
+static inline void fscl_mutex_unlock(fscl_mutex_t* mutex) { pthread_mutex_unlock(mutex); }
+
+static inline void fscl_cond_init(fscl_cond_t* cond) { pthread_cond_init(cond, NULL); }
+static inline void fscl_cond_destroy(fscl_cond_t* cond) { pthread_cond_destroy(cond); }
+static inline void fscl_cond_wait(fscl_cond_t* cond, fscl_mutex_t* mutex) { pthread_cond_wait(cond, mutex); }
+static inline void fscl_cond_signal(fscl_cond_t* cond) { pthread_cond_signal(cond); }
+static inline void fscl_cond_broadcast(fscl_cond_t* cond) { pthread_cond_broadcast(cond); }
+static inline void fscl_cond_timedwait_ms(fscl_cond_t* cond, fscl_mutex_t* mutex, unsigned long ms) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += (time_t)(ms / 1000);
+    deadline.tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    pthread_cond_timedwait(cond, mutex, &deadline);
+}
+
+static inline bool fscl_tls_create(fscl_tls_t* key, void (*destructor)(void* value)) {
+    return pthread_key_create(key, destructor) == 0;
+}
+static inline void* fscl_tls_get(fscl_tls_t key) { return pthread_getspecific(key); }
+static inline void fscl_tls_set(fscl_tls_t key, void* value) { pthread_setspecific(key, value); }
+
+static inline size_t fscl_cpu_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+}
+
+static inline unsigned long long fscl_time_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+}
+#endif
+
+// Thread entry trampoline so callers use one signature on every platform
+typedef struct {
+    void (*entry)(void* arg);
+    void* arg;
+} fscl_thread_start_t;
+
+#ifdef _WIN32
+static inline DWORD WINAPI fscl_thread_main(LPVOID param) {
+    fscl_thread_start_t start = *(fscl_thread_start_t*)param;
+    free(param);
+    start.entry(start.arg);
+    return 0;
+}
+#else
+static inline void* fscl_thread_main(void* param) {
+    fscl_thread_start_t start = *(fscl_thread_start_t*)param;
+    free(param);
+    start.entry(start.arg);
+    return NULL;
+}
+#endif
+
+static inline bool fscl_thread_create(fscl_thread_t* thread, void (*entry)(void* arg), void* arg) {
+    fscl_thread_start_t* start = malloc(sizeof(fscl_thread_start_t));
+    if (start == NULL) {
+        return false;
+    }
+    start->entry = entry;
+    start->arg = arg;
+#ifdef _WIN32
+    *thread = CreateThread(NULL, 0, fscl_thread_main, start, 0, NULL);
+    if (*thread == NULL) {
+        free(start);
+        return false;
+    }
+#else
+    if (pthread_create(thread, NULL, fscl_thread_main, start) != 0) {
+        free(start);
+        return false;
+    }
+#endif
+    return true;
+}
+
+static inline void fscl_thread_join(fscl_thread_t thread) {
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+#endif
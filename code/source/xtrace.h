@@ -0,0 +1,57 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_XTRACE_H
+#define FSCL_XTRACE_H
+
+// Probe points used inside the library; see trace.h for the modes
+
+#include "fossil/xpattern/trace.h"
+#include <stdatomic.h>
+
+#ifndef FSCL_TRACE
+#define FSCL_TRACE FSCL_TRACE_NONE
+#endif
+
+#if FSCL_TRACE == FSCL_TRACE_USDT
+#include <sys/sdt.h>
+#define FSCL_TRACE_(probe, event, a0, a1) \
+    DTRACE_PROBE2(fscl_xpattern, probe, (uintptr_t)(a0), (uintptr_t)(a1))
+#define FSCL_TRACE_CONTRACT_VIOLATION(kind, message, file, line) \
+    DTRACE_PROBE4(fscl_xpattern, contract_violation, kind, message, file, line)
+#elif FSCL_TRACE == FSCL_TRACE_RING
+extern atomic_bool fscl_trace_active;
+#define FSCL_TRACE_(probe, event, a0, a1)                                                        \
+    do {                                                                                          \
+        if (atomic_load_explicit(&fscl_trace_active, memory_order_relaxed)) {                    \
+            fscl_trace_record((event), (uint64_t)(uintptr_t)(a0), (uint64_t)(uintptr_t)(a1));    \
+        }                                                                                         \
+    } while (0)
+#define FSCL_TRACE_CONTRACT_VIOLATION(kind, message, file, line) \
+    FSCL_TRACE_(contract_violation, CTRACE_CONTRACT_VIOLATION, message, line)
+#else
+#define FSCL_TRACE_(probe, event, a0, a1) ((void)0)
+#define FSCL_TRACE_CONTRACT_VIOLATION(kind, message, file, line) ((void)0)
+#endif
+
+#define FSCL_TRACE_NOTIFY_BEGIN(subject, count) \
+    FSCL_TRACE_(notify_begin, CTRACE_NOTIFY_BEGIN, subject, count)
+#define FSCL_TRACE_NOTIFY_END(subject, count) \
+    FSCL_TRACE_(notify_end, CTRACE_NOTIFY_END, subject, count)
+#define FSCL_TRACE_OBSERVER_DISPATCH(subject, observer) \
+    FSCL_TRACE_(observer_dispatch, CTRACE_OBSERVER_DISPATCH, subject, observer)
+#define FSCL_TRACE_LAZY_FORCE_BEGIN(lazy) \
+    FSCL_TRACE_(lazy_force_begin, CTRACE_LAZY_FORCE_BEGIN, lazy, (lazy)->type)
+#define FSCL_TRACE_LAZY_FORCE_END(lazy) \
+    FSCL_TRACE_(lazy_force_end, CTRACE_LAZY_FORCE_END, lazy, (lazy)->type)
+
+#endif
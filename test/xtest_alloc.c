@@ -0,0 +1,213 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/alloc.h" // lib source code
+#include "fossil/xpattern/contract.h"
+#include "fossil/xpattern/lazy.h"
+#include "fossil/xpattern/lazy_expire.h"
+#include "fossil/xpattern/lazy_future.h"
+#include "fossil/xpattern/lazy_memo.h"
+#include "fossil/xpattern/lazy_stream.h"
+#include "fossil/xpattern/observer.h"
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include <string.h>
+
+typedef struct {
+    int allocs;
+    int frees;
+} counting;
+
+static void* counting_alloc(void* context, size_t size) {
+    ((counting*)context)->allocs++;
+    return malloc(size);
+}
+
+static void counting_free(void* context, void* ptr, size_t size) {
+    (void)size;
+    ((counting*)context)->frees++;
+    free(ptr);
+}
+
+static void observer_noop(void* data) {
+    (void)data;
+}
+
+static const char* echo(const char* input) {
+    return input;
+}
+
+static void answer(clazy* lazy, void* context) {
+    (void)context;
+    fscl_lazy_set_int(lazy, 42);
+}
+
+static void indices(clazy* out, size_t index, void* context) {
+    (void)context;
+    fscl_lazy_set_int(out, (int)index);
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_alloc_arena) {
+    unsigned char buffer[256];
+    calloc_arena arena;
+    fscl_alloc_arena_init(&arena, buffer, sizeof(buffer));
+
+    char* first = fscl_alloc(&arena.allocator, 16);
+    TEST_ASSERT_NOT_CNULLPTR(first);
+    char* second = fscl_alloc(&arena.allocator, 16);
+    TEST_ASSERT_NOT_CNULLPTR(second);
+    TEST_ASSERT_TRUE(second > first);
+
+    // The most recent block grows in place
+    strcpy(second, "arena");
+    TEST_ASSERT_TRUE(fscl_realloc(&arena.allocator, second, 16, 64) == second);
+    TEST_ASSERT_TRUE(strcmp(second, "arena") == 0);
+
+    TEST_ASSERT_CNULLPTR(fscl_alloc(&arena.allocator, 1024));
+    fscl_alloc_arena_reset(&arena);
+    TEST_ASSERT_TRUE(fscl_alloc(&arena.allocator, 16) == (void*)first);
+}
+
+XTEST_CASE(test_alloc_pool) {
+    unsigned char buffer[512];
+    calloc_pool pool;
+    TEST_ASSERT_TRUE(fscl_alloc_pool_init(&pool, buffer, sizeof(buffer), 48));
+    size_t blocks = fscl_alloc_pool_available(&pool);
+    TEST_ASSERT_TRUE(blocks > 0);
+
+    void* block = fscl_alloc(&pool.allocator, 40);
+    TEST_ASSERT_NOT_CNULLPTR(block);
+    TEST_ASSERT_CNULLPTR(fscl_alloc(&pool.allocator, pool.block_size + 1));
+    TEST_ASSERT_TRUE(fscl_alloc_pool_available(&pool) == blocks - 1);
+
+    fscl_free(&pool.allocator, block, 40);
+    TEST_ASSERT_TRUE(fscl_alloc_pool_available(&pool) == blocks);
+
+    for (size_t i = 0; i < blocks; ++i) {
+        TEST_ASSERT_NOT_CNULLPTR(fscl_alloc(&pool.allocator, 8));
+    }
+    TEST_ASSERT_CNULLPTR(fscl_alloc(&pool.allocator, 8));
+}
+
+XTEST_CASE(test_alloc_modules) {
+    counting counts = { 0, 0 };
+    callocator allocator = { counting_alloc, NULL, counting_free, &counts };
+
+    // Per-object allocators
+    csubject subject;
+    cobserver observers[3] = { { observer_noop }, { observer_noop }, { observer_noop } };
+    fscl_observe_create_with(&subject, &allocator);
+    for (int i = 0; i < 3; ++i) {
+        fscl_observe_add_observer(&subject, &observers[i]);
+    }
+    fscl_observe_remove_observer(&subject, &observers[1]);
+    TEST_ASSERT_EQUAL_INT(2, subject.numObservers);
+    TEST_ASSERT_TRUE(subject.observers[1] == &observers[2]);
+    fscl_observe_erase(&subject);
+    TEST_ASSERT_EQUAL_INT(counts.allocs, counts.frees);
+
+    // The default allocator is captured at creation
+    fscl_alloc_set_default(&allocator);
+    clazy left = fscl_lazy_create(CLAZY_STRING);
+    clazy right = fscl_lazy_create(CLAZY_STRING);
+    clazy joined = fscl_lazy_create(CLAZY_STRING);
+    ccontract* contract = fscl_contract_create(NULL, NULL);
+    fscl_alloc_set_default(NULL);
+    TEST_ASSERT_TRUE(fscl_alloc_default() == fscl_alloc_heap());
+
+    fscl_lazy_set_cstring(&left, "lazy ");
+    fscl_lazy_set_cstring(&right, "arena");
+    fscl_lazy_concat_cstrings(&joined, &left, &right);
+    TEST_ASSERT_TRUE(strcmp(joined.cache.memoized_string.data, "lazy arena") == 0);
+    TEST_ASSERT_NOT_CNULLPTR(contract);
+
+    fscl_lazy_erase(&left);
+    fscl_lazy_erase(&right);
+    fscl_lazy_erase(&joined);
+    fscl_contract_destroy(contract);
+    TEST_ASSERT_TRUE(counts.allocs >= 7);
+    TEST_ASSERT_EQUAL_INT(counts.allocs, counts.frees);
+}
+
+XTEST_CASE(test_alloc_lazy_arena) {
+    unsigned char buffer[256];
+    calloc_arena arena;
+    fscl_alloc_arena_init(&arena, buffer, sizeof(buffer));
+
+    clazy text = fscl_lazy_create(CLAZY_STRING);
+    fscl_lazy_set_allocator(&text, &arena.allocator);
+    fscl_lazy_set_cstring(&text, "request scoped");
+    TEST_ASSERT_TRUE((unsigned char*)text.cache.memoized_string.data >= buffer);
+    TEST_ASSERT_TRUE((unsigned char*)text.cache.memoized_string.data < buffer + sizeof(buffer));
+    TEST_ASSERT_TRUE(strcmp(text.cache.memoized_string.data, "request scoped") == 0);
+
+    // Freeing the most recent block hands its space back
+    fscl_lazy_erase(&text);
+    TEST_ASSERT_TRUE(arena.used == 0);
+}
+
+XTEST_CASE(test_alloc_lazy_modules) {
+    counting counts = { 0, 0 };
+    callocator allocator = { counting_alloc, NULL, counting_free, &counts };
+
+    // Only creation sees the counting allocator; later blocks still use it
+    fscl_alloc_set_default(&allocator);
+    clazy_memo memo;
+    TEST_ASSERT_TRUE(fscl_lazy_memo_create_cstring(&memo, echo, 4, true));
+    clazy_expire expire;
+    TEST_ASSERT_TRUE(fscl_lazy_expire_create(&expire, CLAZY_INT, answer, NULL, 0, 0));
+    clazy_stream stream = fscl_lazy_stream_create(CLAZY_INT, indices, NULL, 8);
+    clazy_prefetch prefetch;
+    TEST_ASSERT_TRUE(fscl_lazy_prefetch_create(&prefetch, &stream, 4));
+    clazy pending = fscl_lazy_create_thunk(CLAZY_INT, answer, NULL);
+    fscl_alloc_set_default(NULL);
+    int created = counts.allocs;
+    TEST_ASSERT_TRUE(created >= 4);
+
+    clazy text = fscl_lazy_create(CLAZY_STRING);
+    fscl_lazy_set_cstring(&text, "key");
+    fscl_lazy_memo_map_cstring(&memo, &text);
+    TEST_ASSERT_TRUE(strcmp("key", fscl_lazy_force_string(&text)) == 0);
+    fscl_lazy_erase(&text);
+    TEST_ASSERT_EQUAL_INT(created + 2, counts.allocs);
+    TEST_ASSERT_EQUAL_INT(42, fscl_lazy_expire_force_int(&expire));
+    clazy item;
+    size_t seen = 0;
+    while (fscl_lazy_prefetch_next(&prefetch, &item)) {
+        fscl_lazy_erase(&item);
+        seen++;
+    }
+    TEST_ASSERT_EQUAL_INT(8, seen);
+    fscl_lazy_spawn(&pending);
+    TEST_ASSERT_EQUAL_INT(42, fscl_lazy_force_int(&pending));
+
+    fscl_lazy_memo_erase(&memo);
+    fscl_lazy_expire_erase(&expire);
+    fscl_lazy_prefetch_erase(&prefetch);
+    fscl_lazy_erase(&pending);
+    TEST_ASSERT_EQUAL_INT(counts.allocs, counts.frees);
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_alloc_group) {
+    XTEST_RUN_UNIT(test_alloc_arena);
+    XTEST_RUN_UNIT(test_alloc_pool);
+    XTEST_RUN_UNIT(test_alloc_modules);
+    XTEST_RUN_UNIT(test_alloc_lazy_arena);
+    XTEST_RUN_UNIT(test_alloc_lazy_modules);
+} // end of function main
@@ -104,6 +104,117 @@ XTEST_CASE(test_valid_call) {
     free(post_condition_contract);
 }
 
+static int audit_calls = 0;
+
+static bool counted_check(void) {
+    audit_calls++;
+    return true;
+}
+
+XTEST_CASE(test_contract_levels) {
+    int value = 7;
+    const char *str = "Hello";
+
+    // The default (and meson default) level is full
+    TEST_ASSERT_TRUE(FSCL_REQUIRE(value > 0));
+    TEST_ASSERT_TRUE(FSCL_REQUIRE_NOT_NULL(str, "str"));
+    TEST_ASSERT_TRUE(FSCL_REQUIRE_WITHIN_RANGE(value, 1, 10, "value"));
+    TEST_ASSERT_TRUE(FSCL_REQUIRE_STRING_LENGTH(str, 1, 10, "str"));
+    TEST_ASSERT_TRUE(FSCL_ENSURE(value == 7));
+
+#if FSCL_CONTRACT_LEVEL >= FSCL_CONTRACT_LEVEL_FULL
+    TEST_ASSERT_FALSE(FSCL_REQUIRE_POSITIVE(-value, "value"));
+    TEST_ASSERT_FALSE(FSCL_ASSERT(str == NULL));
+#endif
+
+    // Checks above the configured level never evaluate their condition
+    FSCL_AUDIT(counted_check());
+#if FSCL_CONTRACT_LEVEL >= FSCL_CONTRACT_LEVEL_AUDIT
+    TEST_ASSERT_EQUAL_INT(1, audit_calls);
+#else
+    TEST_ASSERT_EQUAL_INT(0, audit_calls);
+#endif
+}
+
+static int pre_calls = 0;
+
+static bool counted_pre(void) {
+    pre_calls++;
+    return false;
+}
+
+static ccontract static_contract = FSCL_CONTRACT_INIT(counted_pre, NULL);
+
+XTEST_CASE(test_contract_static_and_arena) {
+    pre_calls = 0;
+    TEST_ASSERT_FALSE(fscl_contract_check_pre(&static_contract));
+    TEST_ASSERT_EQUAL_INT(1, pre_calls);
+
+    ccontract local;
+    fscl_contract_init(&local, NULL, NULL);
+    TEST_ASSERT_TRUE(fscl_contract_check_pre(&local));
+
+    ccontract storage[2];
+    ccontract_arena arena;
+    fscl_contract_arena_init(&arena, storage, 2);
+    TEST_ASSERT_NOT_CNULLPTR(fscl_contract_arena_create(&arena, counted_pre, NULL));
+    TEST_ASSERT_NOT_CNULLPTR(fscl_contract_arena_create(&arena, NULL, NULL));
+    TEST_ASSERT_CNULLPTR(fscl_contract_arena_create(&arena, NULL, NULL));
+    fscl_contract_arena_reset(&arena);
+    TEST_ASSERT_NOT_CNULLPTR(fscl_contract_arena_create(&arena, NULL, NULL));
+
+    ccontract *heap = fscl_contract_create(NULL, NULL);
+    TEST_ASSERT_NOT_CNULLPTR(heap);
+    fscl_contract_registry_add(heap, "heap");
+    fscl_contract_destroy(heap);
+    TEST_ASSERT_CNULLPTR(fscl_contract_registry_find("heap"));
+}
+
+XTEST_CASE(test_contract_brace_initialized) {
+    // Contracts set up the way the original struct allowed stay enabled
+    ccontract braced = { counted_pre, NULL };
+    ccontract zeroed;
+    memset(&zeroed, 0, sizeof(zeroed));
+    zeroed.pre_condition = counted_pre;
+
+    pre_calls = 0;
+    TEST_ASSERT_FALSE(fscl_contract_check_pre(&braced));
+    TEST_ASSERT_FALSE(fscl_contract_check_pre(&zeroed));
+    TEST_ASSERT_EQUAL_INT(2, pre_calls);
+
+    // Destroy leaves contracts the library does not own alone
+    fscl_contract_destroy(&braced);
+    fscl_contract_destroy(&static_contract);
+    TEST_ASSERT_FALSE(fscl_contract_check_pre(&braced));
+    TEST_ASSERT_EQUAL_INT(3, pre_calls);
+
+    ccontract *heap = fscl_contract_create_with(counted_pre, NULL, NULL);
+    TEST_ASSERT_NOT_CNULLPTR(heap);
+    TEST_ASSERT_TRUE(heap->allocator == fscl_alloc_heap());
+    fscl_contract_destroy(heap);
+}
+
+XTEST_CASE(test_contract_registry) {
+    pre_calls = 0;
+    size_t id = fscl_contract_registry_add(&static_contract, "static");
+    TEST_ASSERT_TRUE(id != 0);
+    TEST_ASSERT_TRUE(fscl_contract_registry_lookup(id) == &static_contract);
+    TEST_ASSERT_TRUE(fscl_contract_registry_find("static") == &static_contract);
+    TEST_ASSERT_CNULLPTR(fscl_contract_registry_find("missing"));
+
+    // Disabled contracts pass without running their condition
+    TEST_ASSERT_TRUE(fscl_contract_registry_enable(id, false));
+    TEST_ASSERT_TRUE(fscl_contract_check_pre(&static_contract));
+    TEST_ASSERT_EQUAL_INT(0, pre_calls);
+    TEST_ASSERT_TRUE(fscl_contract_registry_enable(id, true));
+    TEST_ASSERT_FALSE(fscl_contract_check_pre(&static_contract));
+    TEST_ASSERT_EQUAL_INT(1, pre_calls);
+
+    fscl_contract_registry_remove(&static_contract);
+    TEST_ASSERT_CNULLPTR(fscl_contract_registry_lookup(id));
+    TEST_ASSERT_FALSE(fscl_contract_registry_enable(id, false));
+}
+
 //
 // XUNIT-TEST RUNNER
 //
@@ -111,4 +222,8 @@ XTEST_DEFINE_POOL(test_contract_group) {
     XTEST_RUN_UNIT(test_valid_basic_call);
     XTEST_RUN_UNIT(test_invalid_call);
     XTEST_RUN_UNIT(test_valid_call);
+    XTEST_RUN_UNIT(test_contract_levels);
+    XTEST_RUN_UNIT(test_contract_static_and_arena);
+    XTEST_RUN_UNIT(test_contract_brace_initialized);
+    XTEST_RUN_UNIT(test_contract_registry);
 } // end of function main
@@ -0,0 +1,140 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/contract_report.h" // lib source code
+#include "fossil/xpattern/contract.h"
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include <string.h>
+
+typedef struct {
+    int calls;
+    int last_line;
+    unsigned long long suppressed;
+} report_log;
+
+static void log_violation(const ccontract_violation* violation, void* context) {
+    report_log* log = context;
+    log->calls++;
+    log->last_line = violation->line;
+    log->suppressed += violation->suppressed;
+}
+
+// Calls back into the reporter, which must not deadlock
+static void reentrant_violation(const ccontract_violation* violation, void* context) {
+    report_log* log = context;
+    log->calls++;
+    log->last_line = violation->line;
+    log->suppressed = fscl_contract_report_stats().reported;
+    fscl_contract_report_flush();
+    fscl_contract_report_sink_callback(reentrant_violation, context);
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_contract_report_rate_limit) {
+    char memory[512];
+    ccontract_report_config config = { 0, 1, 2, 1000 };
+
+    fscl_contract_report_sink_memory(memory, sizeof(memory));
+    TEST_ASSERT_TRUE(fscl_contract_report_start(&config));
+    for (int i = 0; i < 10; ++i) {
+        TEST_ASSERT_FALSE(fscl_contract_assert(false, "hot"));
+    }
+    fscl_contract_report_flush();
+
+    ccontract_report_stats stats = fscl_contract_report_stats();
+    TEST_ASSERT_EQUAL_INT(10, stats.violations);
+    TEST_ASSERT_EQUAL_INT(2, stats.reported);
+    TEST_ASSERT_EQUAL_INT(8, stats.suppressed);
+    TEST_ASSERT_EQUAL_INT(1, stats.sites);
+    TEST_ASSERT_TRUE(strstr(memory, "Contract Violation: hot (assert)") != NULL);
+
+    fscl_contract_report_stop();
+    fscl_contract_report_sink_fd(2);
+}
+
+XTEST_CASE(test_contract_report_callback) {
+    report_log log = { 0, 0, 0 };
+    ccontract_report_config config = { 0, 1, 1, 1000 };
+
+    fscl_contract_report_sink_callback(log_violation, &log);
+    TEST_ASSERT_TRUE(fscl_contract_report_start(&config));
+    // Raised directly so the test does not depend on the contract level
+    for (int i = 0; i < 3; ++i) {
+        TEST_ASSERT_FALSE(fscl_contract_fail("require", "i < 0", __FILE__, 100));
+    }
+    TEST_ASSERT_FALSE(fscl_contract_fail("require", "other site", __FILE__, 200));
+    fscl_contract_report_stop();
+
+    // One report per site; the repeats of the first site are folded away
+    ccontract_report_stats stats = fscl_contract_report_stats();
+    TEST_ASSERT_EQUAL_INT(2, log.calls);
+    TEST_ASSERT_EQUAL_INT(2, stats.reported);
+    TEST_ASSERT_EQUAL_INT(2, stats.suppressed);
+    TEST_ASSERT_EQUAL_INT(200, log.last_line);
+    fscl_contract_report_sink_fd(2);
+}
+
+XTEST_CASE(test_contract_report_reentrant_callback) {
+    report_log log = { 0, 0, 0 };
+    ccontract_report_config config = { 0, 1, 100, 1000 };
+
+    fscl_contract_report_sink_callback(reentrant_violation, &log);
+    TEST_ASSERT_TRUE(fscl_contract_report_start(&config));
+    for (int i = 0; i < 40; ++i) {
+        TEST_ASSERT_TRUE(fscl_contract_report_submit("assert", "reentrant", __FILE__, 300 + i));
+    }
+    fscl_contract_report_flush();
+
+    // Flush returns only once every drained report reached the callback.
+    // Batches drained by different threads may arrive in either order.
+    TEST_ASSERT_EQUAL_INT(40, log.calls);
+    TEST_ASSERT_TRUE(log.last_line >= 300 && log.last_line < 340);
+    TEST_ASSERT_EQUAL_INT(40, log.suppressed);
+    fscl_contract_report_stop();
+    fscl_contract_report_sink_fd(2);
+}
+
+XTEST_CASE(test_contract_report_ring_full) {
+    ccontract_report_config config = { 4, 1, 1, 1000 };
+    char memory[256];
+
+    fscl_contract_report_sink_memory(memory, sizeof(memory));
+    TEST_ASSERT_TRUE(fscl_contract_report_start(&config));
+    for (int i = 0; i < 300; ++i) {
+        TEST_ASSERT_TRUE(fscl_contract_report_submit("assert", "burst", NULL, 0));
+    }
+    fscl_contract_report_flush();
+
+    // Nothing blocks: what does not fit in the ring is counted and dropped.
+    // Rings keep their size across restarts, so this one holds 4 or 256.
+    ccontract_report_stats stats = fscl_contract_report_stats();
+    TEST_ASSERT_EQUAL_INT(300, stats.violations + stats.dropped);
+    TEST_ASSERT_TRUE(stats.dropped > 0);
+
+    fscl_contract_report_stop();
+    TEST_ASSERT_FALSE(fscl_contract_report_submit("assert", "late", NULL, 0));
+    fscl_contract_report_sink_fd(2);
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_contract_report_group) {
+    XTEST_RUN_UNIT(test_contract_report_rate_limit);
+    XTEST_RUN_UNIT(test_contract_report_callback);
+    XTEST_RUN_UNIT(test_contract_report_reentrant_callback);
+    XTEST_RUN_UNIT(test_contract_report_ring_full);
+} // end of function main
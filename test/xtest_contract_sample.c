@@ -0,0 +1,174 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/contract_sample.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include <string.h>
+
+// Each test uses its own sites so it passes when run alone
+FSCL_CONTRACT_SITE(every_fourth, "every_fourth", 4);
+FSCL_CONTRACT_SITE(string_site, "string_length", 2);
+FSCL_CONTRACT_SITE(audit_site, "audit", 1);
+FSCL_CONTRACT_SITE(macro_site, "macro", 4);
+FSCL_CONTRACT_SITE(profiled_site, "profiled", 1);
+
+static int evaluations = 0;
+
+static bool counted(void) {
+    evaluations++;
+    return true;
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_contract_sample_period) {
+    ccontract_sample_stats before = fscl_contract_sample_stats(&every_fourth);
+    int runs = 0;
+    for (int i = 0; i < 100; ++i) {
+        runs += fscl_contract_sample(&every_fourth) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL_INT(25, runs);
+
+    ccontract_sample_stats stats = fscl_contract_sample_stats(&every_fourth);
+    TEST_ASSERT_EQUAL_INT(25, stats.run - before.run);
+    TEST_ASSERT_EQUAL_INT(75, stats.skipped - before.skipped);
+
+    // A period of 0 switches the site off
+    fscl_contract_sample_set_rate(&every_fourth, 0);
+    runs = 0;
+    for (int i = 0; i < 100; ++i) {
+        runs += fscl_contract_sample(&every_fourth) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL_INT(0, runs);
+    fscl_contract_sample_set_rate(&every_fourth, 4);
+}
+
+XTEST_CASE(test_contract_sample_global) {
+    ccontract_sample_stats before = fscl_contract_sample_totals();
+    evaluations = 0;
+    fscl_contract_sample_set_global_rate(1);
+    for (int i = 0; i < 10; ++i) {
+        TEST_ASSERT_TRUE(fscl_contract_require_custom_condition_sampled(&audit_site, counted, "counted"));
+        TEST_ASSERT_TRUE(fscl_contract_require_string_length_sampled(&string_site, "abc", 1, 5, "str"));
+    }
+    fscl_contract_sample_set_global_rate(0);
+    TEST_ASSERT_EQUAL_INT(10, evaluations);
+
+    // Back on the per-site period: a failing string is only caught when sampled
+    int caught = 0;
+    for (int i = 0; i < 10; ++i) {
+        caught += fscl_contract_require_string_length_sampled(&string_site, "", 1, 5, "str") ? 0 : 1;
+    }
+    TEST_ASSERT_EQUAL_INT(5, caught);
+
+    // 10 + 10 runs at the global rate, then 5 at the string site's own rate
+    ccontract_sample_stats totals = fscl_contract_sample_totals();
+    TEST_ASSERT_EQUAL_INT(10 + 10 + 5, totals.run - before.run);
+}
+
+XTEST_CASE(test_contract_sample_macro) {
+    ccontract_sample_stats before = fscl_contract_sample_stats(&macro_site);
+    int value = 3;
+    for (int i = 0; i < 8; ++i) {
+        TEST_ASSERT_TRUE(FSCL_REQUIRE_SAMPLED(&macro_site, value > 0));
+    }
+    ccontract_sample_stats stats = fscl_contract_sample_stats(&macro_site);
+#if FSCL_CONTRACT_LEVEL >= FSCL_CONTRACT_LEVEL_PRE
+    TEST_ASSERT_EQUAL_INT(2, stats.run - before.run);
+#else
+    TEST_ASSERT_EQUAL_INT(0, stats.run - before.run);
+#endif
+}
+
+XTEST_CASE(test_contract_profile_snapshot) {
+    ccontract_profile_entry entries[64];
+    const ccontract_profile_entry* found = NULL;
+
+    fscl_contract_profile_reset();
+    for (int i = 0; i < 3; ++i) {
+        fscl_contract_profile_begin(&profiled_site);
+        TEST_ASSERT_EQUAL_INT(i != 1, fscl_contract_profile_end(&profiled_site, i != 1));
+    }
+
+    // The site macro only records when profiling is compiled in
+    int value = 1;
+    FSCL_REQUIRE_SITE(&profiled_site, value > 0);
+
+    size_t count = fscl_contract_profile_snapshot(NULL, 0);
+    TEST_ASSERT_TRUE(count >= 1 && count <= 64);
+    TEST_ASSERT_EQUAL_INT(count, fscl_contract_profile_snapshot(entries, 64));
+    for (size_t i = 0; i < count; ++i) {
+        if (strcmp(entries[i].name, "profiled") == 0) {
+            found = &entries[i];
+        }
+        // Most expensive first
+        TEST_ASSERT_TRUE(i == 0 || entries[i - 1].cycles >= entries[i].cycles);
+    }
+    TEST_ASSERT_NOT_CNULLPTR(found);
+    TEST_ASSERT_EQUAL_INT(1, found->failures);
+    TEST_ASSERT_TRUE(found->line > 0);
+#if FSCL_CONTRACT_PROFILE && FSCL_CONTRACT_LEVEL >= FSCL_CONTRACT_LEVEL_PRE
+    TEST_ASSERT_EQUAL_INT(4, found->evaluations);
+#else
+    TEST_ASSERT_EQUAL_INT(3, found->evaluations);
+#endif
+}
+
+static const ccontract_profile_entry* profile_find(ccontract_profile_entry* entries, size_t count, const char* name) {
+    for (size_t i = 0; i < count; ++i) {
+        if (strcmp(entries[i].name, name) == 0) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+XTEST_CASE(test_contract_profile_implicit_sites) {
+    ccontract_profile_entry entries[64];
+    int value = 2;
+
+    fscl_contract_profile_reset();
+    for (int i = 0; i < 5; ++i) {
+        TEST_ASSERT_TRUE(FSCL_REQUIRE(value > 1));
+    }
+    TEST_ASSERT_FALSE(fscl_contract_require_positive(-value, "value"));
+
+    size_t count = fscl_contract_profile_snapshot(entries, 64);
+    TEST_ASSERT_TRUE(count <= 64);
+    const ccontract_profile_entry* plain = profile_find(entries, count, "value > 1");
+    const ccontract_profile_entry* positive = profile_find(entries, count, "require_positive");
+#if FSCL_CONTRACT_PROFILE && (defined(__GNUC__) || defined(__clang__)) && FSCL_CONTRACT_LEVEL >= FSCL_CONTRACT_LEVEL_PRE
+    // Plain checks and the requirement functions each get their own site
+    TEST_ASSERT_NOT_CNULLPTR(plain);
+    TEST_ASSERT_EQUAL_INT(5, plain->evaluations);
+    TEST_ASSERT_EQUAL_INT(0, plain->failures);
+    TEST_ASSERT_NOT_CNULLPTR(positive);
+    TEST_ASSERT_EQUAL_INT(1, positive->failures);
+#else
+    TEST_ASSERT_CNULLPTR(plain);
+    (void)positive;
+#endif
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_contract_sample_group) {
+    XTEST_RUN_UNIT(test_contract_sample_period);
+    XTEST_RUN_UNIT(test_contract_sample_global);
+    XTEST_RUN_UNIT(test_contract_sample_macro);
+    XTEST_RUN_UNIT(test_contract_profile_snapshot);
+    XTEST_RUN_UNIT(test_contract_profile_implicit_sites);
+} // end of function main
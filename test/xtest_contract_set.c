@@ -0,0 +1,85 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/contract_set.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include <string.h>
+
+typedef struct {
+    const char* user;
+    int age;
+} request;
+
+static bool has_user(const void* context) {
+    return ((const request*)context)->user != NULL;
+}
+
+static bool adult(const void* context) {
+    return ((const request*)context)->age >= 18;
+}
+
+static bool short_user(const void* context) {
+    const request* r = context;
+    return r->user == NULL || strlen(r->user) < 16;
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_contract_set_check) {
+    ccontract_rule storage[3];
+    ccontract_set set;
+    request good = { "ada", 36 };
+    request minor = { "kid", 12 };
+
+    fscl_contract_set_init(&set, storage, 3);
+    TEST_ASSERT_TRUE(fscl_contract_set_add(&set, has_user, "user"));
+    TEST_ASSERT_TRUE(fscl_contract_set_add(&set, short_user, "user length"));
+    TEST_ASSERT_TRUE(fscl_contract_set_add(&set, adult, "age"));
+    TEST_ASSERT_FALSE(fscl_contract_set_add(&set, adult, "full"));
+
+    TEST_ASSERT_CNULLPTR(fscl_contract_set_check(&set, &good));
+    const ccontract_rule* failed = fscl_contract_set_check(&set, &minor);
+    TEST_ASSERT_NOT_CNULLPTR(failed);
+    TEST_ASSERT_TRUE(strcmp(failed->name, "age") == 0);
+    TEST_ASSERT_FALSE(fscl_contract_set_require(&set, &minor));
+}
+
+XTEST_CASE(test_contract_set_adaptive) {
+    ccontract_rule storage[3];
+    ccontract_set set;
+    request minor = { "kid", 12 };
+
+    fscl_contract_set_init(&set, storage, 3);
+    fscl_contract_set_add(&set, has_user, "user");
+    fscl_contract_set_add(&set, short_user, "user length");
+    fscl_contract_set_add(&set, adult, "age");
+    fscl_contract_set_adaptive(&set, 8);
+
+    // The predicate that always fails moves to the front
+    for (int i = 0; i < 16; ++i) {
+        const ccontract_rule* failed = fscl_contract_set_check(&set, &minor);
+        TEST_ASSERT_TRUE(failed != NULL && failed->check == adult);
+    }
+    TEST_ASSERT_TRUE(set.rules[0].check == adult);
+    TEST_ASSERT_EQUAL_INT(3, set.count);
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_contract_set_group) {
+    XTEST_RUN_UNIT(test_contract_set_check);
+    XTEST_RUN_UNIT(test_contract_set_adaptive);
+} // end of function main
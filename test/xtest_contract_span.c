@@ -0,0 +1,104 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/contract_span.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include <math.h>
+#include <stdlib.h>
+
+#define SPAN_COUNT 100003 // Not a multiple of any vector width
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_contract_span_length) {
+    int array[] = {1, 2, 3, 4, 5};
+    ccontract_span span = FSCL_CONTRACT_SPAN(array);
+
+    TEST_ASSERT_EQUAL_INT(5, span.length);
+    TEST_ASSERT_TRUE(fscl_contract_require_span_length(span, 5, sizeof(int), "array"));
+    TEST_ASSERT_FALSE(fscl_contract_require_span_length(span, 4, sizeof(int), "array"));
+    TEST_ASSERT_FALSE(fscl_contract_require_span_length(fscl_contract_span(array, 5, sizeof(char)), 5, sizeof(int), "array"));
+}
+
+XTEST_CASE(test_contract_span_int_range) {
+    int* values = malloc(SPAN_COUNT * sizeof(int));
+    TEST_ASSERT_NOT_CNULLPTR(values);
+    for (size_t i = 0; i < SPAN_COUNT; ++i) {
+        values[i] = (int)(i % 100);
+    }
+
+    TEST_ASSERT_TRUE(fscl_contract_require_all_within_range(values, SPAN_COUNT, 0, 99, "values"));
+    TEST_ASSERT_EQUAL_INT(SPAN_COUNT, fscl_contract_find_outside_range(values, SPAN_COUNT, 0, 99));
+
+    // Failures inside a vector block, and in the scalar tail
+    values[70001] = 100;
+    TEST_ASSERT_EQUAL_INT(70001, fscl_contract_find_outside_range(values, SPAN_COUNT, 0, 99));
+    values[70001] = 1;
+    values[SPAN_COUNT - 1] = -1;
+    TEST_ASSERT_EQUAL_INT(SPAN_COUNT - 1, fscl_contract_find_outside_range(values, SPAN_COUNT, 0, 99));
+    TEST_ASSERT_FALSE(fscl_contract_require_all_within_range(values, SPAN_COUNT, 0, 99, "values"));
+    free(values);
+}
+
+XTEST_CASE(test_contract_span_double_range) {
+    double* values = malloc(SPAN_COUNT * sizeof(double));
+    TEST_ASSERT_NOT_CNULLPTR(values);
+    for (size_t i = 0; i < SPAN_COUNT; ++i) {
+        values[i] = (double)(i % 10) / 10.0;
+    }
+
+    TEST_ASSERT_TRUE(fscl_contract_require_all_within_double_range(values, SPAN_COUNT, 0.0, 1.0, "values"));
+    values[33] = NAN;
+    TEST_ASSERT_EQUAL_INT(33, fscl_contract_find_outside_double_range(values, SPAN_COUNT, 0.0, 1.0));
+    values[33] = 0.5;
+    values[40000] = 1.5;
+    TEST_ASSERT_EQUAL_INT(40000, fscl_contract_find_outside_double_range(values, SPAN_COUNT, 0.0, 1.0));
+    free(values);
+}
+
+XTEST_CASE(test_contract_span_not_null) {
+    static int target = 0;
+    const void** pointers = malloc(SPAN_COUNT * sizeof(void*));
+    TEST_ASSERT_NOT_CNULLPTR(pointers);
+    for (size_t i = 0; i < SPAN_COUNT; ++i) {
+        pointers[i] = &target;
+    }
+
+    TEST_ASSERT_TRUE(fscl_contract_require_all_not_null(pointers, SPAN_COUNT, "pointers"));
+    pointers[12345] = NULL;
+    TEST_ASSERT_EQUAL_INT(12345, fscl_contract_find_null(pointers, SPAN_COUNT));
+    TEST_ASSERT_FALSE(fscl_contract_require_all_not_null(pointers, SPAN_COUNT, "pointers"));
+    free(pointers);
+}
+
+XTEST_CASE(test_contract_span_string_bounded) {
+    // Not NUL-terminated: the scan must stop at max_length + 1 bytes
+    const char unterminated[8] = {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'};
+
+    TEST_ASSERT_TRUE(fscl_contract_require_string_length_bounded("Hello", 1, 10, "str"));
+    TEST_ASSERT_FALSE(fscl_contract_require_string_length_bounded("", 1, 10, "str"));
+    TEST_ASSERT_FALSE(fscl_contract_require_string_length_bounded(unterminated, 1, 4, "str"));
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_contract_span_group) {
+    XTEST_RUN_UNIT(test_contract_span_length);
+    XTEST_RUN_UNIT(test_contract_span_int_range);
+    XTEST_RUN_UNIT(test_contract_span_double_range);
+    XTEST_RUN_UNIT(test_contract_span_not_null);
+    XTEST_RUN_UNIT(test_contract_span_string_bounded);
+} // end of function main
@@ -0,0 +1,75 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_XPATTERN_INLINE
+#define FSCL_XPATTERN_INLINE
+#endif
+#include "fossil/xpattern/contract.h" // lib source code
+#include "fossil/xpattern/lazy.h"
+#include "fossil/xpattern/observer.h"
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+static void inline_thunk(clazy* lazy, void* context) {
+    fscl_lazy_set_int(lazy, *(int*)context);
+}
+
+static void inline_noop(void* data) {
+    (void)data;
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_inline_lazy) {
+    int seed = 21;
+    clazy lazy = fscl_lazy_create_thunk(CLAZY_INT, inline_thunk, &seed);
+    // The first force falls back to the library, the second reads the cache
+    TEST_ASSERT_EQUAL_INT(21, fscl_lazy_force_int(&lazy));
+    seed = 0;
+    TEST_ASSERT_EQUAL_INT(21, fscl_lazy_force_int(&lazy));
+
+    fscl_lazy_set_double(&lazy, 2.5);
+    TEST_ASSERT_TRUE(fscl_lazy_force_double(&lazy) == 2.5);
+
+    clazy text = fscl_lazy_create(CLAZY_STRING);
+    TEST_ASSERT_CNULLPTR(fscl_lazy_force_string(&text));
+    fscl_lazy_erase(&text);
+}
+
+XTEST_CASE(test_inline_observer_and_contract) {
+    csubject subject;
+    cobserver observer = { inline_noop };
+    fscl_observe_create(&subject);
+    TEST_ASSERT_FALSE(fscl_observe_has_observers(&subject));
+    fscl_observe_add_observer(&subject, &observer);
+    TEST_ASSERT_TRUE(fscl_observe_has_observers(&subject));
+    fscl_observe_erase(&subject);
+
+    TEST_ASSERT_TRUE(fscl_contract_require_positive(3, "value"));
+    TEST_ASSERT_FALSE(fscl_contract_require_positive(0, "value"));
+    TEST_ASSERT_TRUE(fscl_contract_require_within_range(5, 1, 9, "value"));
+    TEST_ASSERT_FALSE(fscl_contract_require_not_null(NULL, "pointer"));
+
+    // The inline definitions and the library's external ones are the same functions
+    bool (*positive)(int, const char*) = fscl_contract_require_positive;
+    TEST_ASSERT_TRUE(positive(1, "value"));
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_inline_group) {
+    XTEST_RUN_UNIT(test_inline_lazy);
+    XTEST_RUN_UNIT(test_inline_observer_and_contract);
+} // end of function main
@@ -14,6 +14,22 @@ Description:
 
 #include <fossil/xtest.h>   // basic test tools
 #include <fossil/xassert.h> // extra asserts
+#include <stdio.h>
+#include <string.h>
+
+static void answer_thunk(clazy* lazy, void* context) {
+    fscl_lazy_set_int(lazy, *(int*)context);
+}
+
+static int64_t twice(int64_t value) {
+    return value * 2;
+}
+
+// Drop the first byte of the buffer
+static clazy_view tail(clazy_view view) {
+    clazy_view rest = { view.data + 1, view.length - 1 };
+    return rest;
+}
 
 //
 // XUNIT TEST CASES
@@ -50,6 +66,71 @@ XTEST_CASE(test_lazy_sequence) {
     fscl_lazy_erase(&sequenceLazy);
 }
 
+XTEST_CASE(test_lazy_thunk) {
+    int answer = 42;
+    clazy thunkLazy = fscl_lazy_create_thunk(CLAZY_INT, answer_thunk, &answer);
+    TEST_ASSERT_FALSE(thunkLazy.is_evaluated);
+    TEST_ASSERT_EQUAL_INT(42, fscl_lazy_force_int(&thunkLazy));
+    fscl_lazy_erase(&thunkLazy);
+}
+
+XTEST_CASE(test_lazy_file_view) {
+    const char *path = "xtest_lazy_file.txt";
+    FILE *file = fopen(path, "wb");
+    TEST_ASSERT_NOT_CNULLPTR(file);
+    fputs("reference data", file);
+    fclose(file);
+
+    clazy fileLazy = fscl_lazy_create_file(path);
+    TEST_ASSERT_FALSE(fileLazy.is_evaluated);
+    clazy_view view = fscl_lazy_force_view(&fileLazy);
+    TEST_ASSERT_EQUAL_INT(14, view.length);
+    TEST_ASSERT_TRUE(memcmp(view.data, "reference data", view.length) == 0);
+    fscl_lazy_erase(&fileLazy);
+    remove(path);
+
+    clazy missingLazy = fscl_lazy_create_file("xtest_lazy_missing.txt");
+    TEST_ASSERT_CNULLPTR(fscl_lazy_force_view(&missingLazy).data);
+    fscl_lazy_erase(&missingLazy);
+}
+
+XTEST_CASE(test_lazy_wide_numbers) {
+    clazy counter = fscl_lazy_create(CLAZY_INT64);
+    TEST_ASSERT_TRUE(fscl_lazy_force_int64(&counter) == 0);
+    fscl_lazy_set_int64(&counter, INT64_C(5000000000));
+    fscl_lazy_map_int64(&counter, twice);
+    TEST_ASSERT_TRUE(fscl_lazy_force_int64(&counter) == INT64_C(10000000000));
+
+    clazy total = fscl_lazy_create(CLAZY_UINT64);
+    fscl_lazy_set_uint64(&total, UINT64_MAX);
+    TEST_ASSERT_TRUE(fscl_lazy_force_uint64(&total) == UINT64_MAX);
+
+    clazy ratio = fscl_lazy_create(CLAZY_DOUBLE);
+    fscl_lazy_set_double(&ratio, 0.25);
+    TEST_ASSERT_TRUE(fscl_lazy_force_double(&ratio) == 0.25);
+
+    clazy handle = fscl_lazy_create(CLAZY_POINTER);
+    fscl_lazy_set_pointer(&handle, &ratio);
+    TEST_ASSERT_TRUE(fscl_lazy_force_pointer(&handle) == &ratio);
+}
+
+XTEST_CASE(test_lazy_bytes) {
+    const unsigned char blob[] = { 0x01, 0x00, 0x02, 0x00 };
+    clazy bytesLazy = fscl_lazy_create(CLAZY_BYTES);
+    TEST_ASSERT_EQUAL_INT(0, fscl_lazy_force_bytes(&bytesLazy).length);
+
+    fscl_lazy_set_bytes(&bytesLazy, blob, sizeof(blob));
+    clazy_bytes bytes = fscl_lazy_force_bytes(&bytesLazy);
+    TEST_ASSERT_EQUAL_INT(4, bytes.length);
+    TEST_ASSERT_TRUE(memcmp(bytes.data, blob, sizeof(blob)) == 0);
+
+    fscl_lazy_map_bytes(&bytesLazy, tail);
+    clazy_view view = fscl_lazy_force_view(&bytesLazy);
+    TEST_ASSERT_EQUAL_INT(3, view.length);
+    TEST_ASSERT_TRUE(memcmp(view.data, blob + 1, 3) == 0);
+    fscl_lazy_erase(&bytesLazy);
+}
+
 //
 // XUNIT-TEST RUNNER
 //
@@ -59,4 +140,8 @@ XTEST_DEFINE_POOL(test_lazy_group) {
     XTEST_RUN_UNIT(test_lazy_char);
     XTEST_RUN_UNIT(test_lazy_string);
     XTEST_RUN_UNIT(test_lazy_sequence);
+    XTEST_RUN_UNIT(test_lazy_thunk);
+    XTEST_RUN_UNIT(test_lazy_file_view);
+    XTEST_RUN_UNIT(test_lazy_wide_numbers);
+    XTEST_RUN_UNIT(test_lazy_bytes);
 } // end of function main
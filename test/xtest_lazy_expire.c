@@ -0,0 +1,121 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/lazy_expire.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+
+// Each call yields the next generation number
+static void next_generation(clazy* lazy, void* context) {
+    int* generation = context;
+    fscl_lazy_set_int(lazy, ++*generation);
+}
+
+// The second computation, the background refresh, waits until released
+typedef struct {
+    atomic_int generation;
+    atomic_bool entered;
+    atomic_bool hold;
+} held_refresh;
+
+static void held_generation(clazy* lazy, void* context) {
+    held_refresh* held = context;
+    int generation = atomic_fetch_add(&held->generation, 1) + 1;
+    if (generation == 2) {
+        atomic_store(&held->entered, true);
+        while (atomic_load(&held->hold)) {
+            sched_yield();
+        }
+    }
+    fscl_lazy_set_int(lazy, generation);
+}
+
+static void config_name(clazy* lazy, void* context) {
+    (void)context;
+    fscl_lazy_set_cstring(lazy, "config-v1");
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_lazy_expire_memoized_within_ttl) {
+    int generation = 0;
+    clazy_expire expire;
+    TEST_ASSERT_TRUE(fscl_lazy_expire_create(&expire, CLAZY_INT, next_generation, &generation, 60000, 0));
+
+    TEST_ASSERT_TRUE(fscl_lazy_expire_is_stale(&expire));
+    TEST_ASSERT_EQUAL_INT(1, fscl_lazy_expire_force_int(&expire));
+    TEST_ASSERT_EQUAL_INT(1, fscl_lazy_expire_force_int(&expire));
+    TEST_ASSERT_FALSE(fscl_lazy_expire_is_stale(&expire));
+
+    fscl_lazy_expire_invalidate(&expire);
+    TEST_ASSERT_EQUAL_INT(2, fscl_lazy_expire_force_int(&expire));
+    fscl_lazy_expire_erase(&expire);
+}
+
+XTEST_CASE(test_lazy_expire_refresh_ahead) {
+    int generation = 0;
+    clazy_expire expire;
+    // The refresh window covers the whole TTL, so every read schedules one
+    TEST_ASSERT_TRUE(fscl_lazy_expire_create(&expire, CLAZY_INT, next_generation, &generation, 60000, 60000));
+
+    TEST_ASSERT_EQUAL_INT(1, fscl_lazy_expire_force_int(&expire));
+    TEST_ASSERT_EQUAL_INT(1, fscl_lazy_expire_force_int(&expire)); // stale-while-revalidate
+    fscl_lazy_expire_erase(&expire);
+    TEST_ASSERT_EQUAL_INT(2, generation);
+}
+
+XTEST_CASE(test_lazy_expire_invalidate_during_refresh) {
+    held_refresh held;
+    atomic_init(&held.generation, 0);
+    atomic_init(&held.entered, false);
+    atomic_init(&held.hold, true);
+    clazy_expire expire;
+    TEST_ASSERT_TRUE(fscl_lazy_expire_create(&expire, CLAZY_INT, held_generation, &held, 60000, 60000));
+
+    // The second read schedules a refresh, which then blocks mid-load
+    TEST_ASSERT_EQUAL_INT(1, fscl_lazy_expire_force_int(&expire));
+    TEST_ASSERT_EQUAL_INT(1, fscl_lazy_expire_force_int(&expire));
+    while (!atomic_load(&held.entered)) {
+        sched_yield();
+    }
+    fscl_lazy_expire_invalidate(&expire);
+    atomic_store(&held.hold, false);
+
+    // The refresh started before the invalidate, so its value is dropped
+    TEST_ASSERT_EQUAL_INT(3, fscl_lazy_expire_force_int(&expire));
+    fscl_lazy_expire_erase(&expire);
+}
+
+XTEST_CASE(test_lazy_expire_string_copy) {
+    char buffer[7];
+    clazy_expire expire;
+    TEST_ASSERT_TRUE(fscl_lazy_expire_create(&expire, CLAZY_STRING, config_name, NULL, 1000, 0));
+
+    TEST_ASSERT_EQUAL_INT(9, fscl_lazy_expire_force_string(&expire, buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(strcmp("config", buffer) == 0);
+    fscl_lazy_expire_erase(&expire);
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_lazy_expire_group) {
+    XTEST_RUN_UNIT(test_lazy_expire_memoized_within_ttl);
+    XTEST_RUN_UNIT(test_lazy_expire_refresh_ahead);
+    XTEST_RUN_UNIT(test_lazy_expire_invalidate_during_refresh);
+    XTEST_RUN_UNIT(test_lazy_expire_string_copy);
+} // end of function main
@@ -0,0 +1,133 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/lazy_format.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include <string.h>
+
+typedef struct {
+    char text[64];
+    size_t length;
+    int flushes;
+} collected;
+
+static bool collect(void* context, const char* data, size_t length) {
+    collected* out = context;
+    if (out->length + length >= sizeof(out->text)) {
+        return false;
+    }
+    memcpy(out->text + out->length, data, length);
+    out->length += length;
+    out->text[out->length] = '\0';
+    out->flushes++;
+    return true;
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_lazy_format_values) {
+    char buffer[16];
+    clazy number = fscl_lazy_create(CLAZY_INT);
+    clazy flag = fscl_lazy_create(CLAZY_BOOL);
+    clazy wide = fscl_lazy_create(CLAZY_INT64);
+
+    fscl_lazy_set_int(&number, -1234567);
+    fscl_lazy_set_bool(&flag, true);
+    fscl_lazy_set_int64(&wide, -9223372036854775807LL - 1);
+
+    TEST_ASSERT_EQUAL_INT(8, fscl_lazy_format(&number, buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(strcmp(buffer, "-1234567") == 0);
+    TEST_ASSERT_EQUAL_INT(4, fscl_lazy_format(&flag, buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(strcmp(buffer, "true") == 0);
+
+    // Truncated like snprintf, but the full length is still reported
+    TEST_ASSERT_EQUAL_INT(20, fscl_lazy_format(&wide, buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(strcmp(buffer, "-92233720368547") == 0);
+
+    fscl_lazy_erase(&number);
+    fscl_lazy_erase(&flag);
+    fscl_lazy_erase(&wide);
+}
+
+XTEST_CASE(test_lazy_format_sink) {
+    char staging[4];
+    collected out = { {0}, 0, 0 };
+    clazy_sink sink;
+    clazy number = fscl_lazy_create(CLAZY_INT);
+    clazy letter = fscl_lazy_create(CLAZY_CHAR);
+
+    fscl_lazy_set_int(&number, 9001);
+    fscl_lazy_set_letter(&letter, 'x');
+    fscl_lazy_sink_callback(&sink, collect, &out, staging, sizeof(staging));
+
+    TEST_ASSERT_TRUE(fscl_lazy_write(&sink, &number));
+    TEST_ASSERT_TRUE(fscl_lazy_write(&sink, &letter));
+    TEST_ASSERT_TRUE(fscl_lazy_sink_flush(&sink));
+    TEST_ASSERT_TRUE(strcmp(out.text, "9001x") == 0);
+    TEST_ASSERT_EQUAL_INT(2, out.flushes);
+
+    // A plain buffer sink fails instead of overflowing
+    fscl_lazy_sink_buffer(&sink, staging, sizeof(staging));
+    TEST_ASSERT_FALSE(fscl_lazy_write(&sink, &number) && fscl_lazy_write(&sink, &letter));
+    TEST_ASSERT_TRUE(sink.failed);
+
+    fscl_lazy_erase(&number);
+    fscl_lazy_erase(&letter);
+}
+
+XTEST_CASE(test_lazy_format_snapshot) {
+    char storage[128];
+    clazy_sink sink;
+    clazy saved[4] = {
+        fscl_lazy_create(CLAZY_INT), fscl_lazy_create(CLAZY_STRING),
+        fscl_lazy_create(CLAZY_DOUBLE), fscl_lazy_create(CLAZY_BOOL)
+    };
+    clazy loaded[4] = {
+        fscl_lazy_create(CLAZY_INT), fscl_lazy_create(CLAZY_STRING),
+        fscl_lazy_create(CLAZY_DOUBLE), fscl_lazy_create(CLAZY_BOOL)
+    };
+    size_t restored = 0;
+
+    fscl_lazy_set_int(&saved[0], -42);
+    fscl_lazy_set_cstring(&saved[1], "warm");
+    fscl_lazy_set_double(&saved[2], 0.1);
+    // saved[3] stays unevaluated and is skipped on load
+
+    fscl_lazy_sink_buffer(&sink, storage, sizeof(storage));
+    TEST_ASSERT_TRUE(fscl_lazy_snapshot_save(&sink, saved, 4));
+    TEST_ASSERT_TRUE(fscl_lazy_snapshot_load(storage, sink.length, loaded, 4, &restored));
+    TEST_ASSERT_EQUAL_INT(3, restored);
+    TEST_ASSERT_EQUAL_INT(-42, fscl_lazy_force_int(&loaded[0]));
+    TEST_ASSERT_TRUE(strcmp(fscl_lazy_force_string(&loaded[1]), "warm") == 0);
+    TEST_ASSERT_TRUE(fscl_lazy_force_double(&loaded[2]) == 0.1);
+    TEST_ASSERT_FALSE(loaded[3].is_evaluated);
+
+    // Truncated snapshots are rejected
+    TEST_ASSERT_FALSE(fscl_lazy_snapshot_load(storage, sink.length - 1, loaded, 4, &restored));
+
+    for (size_t i = 0; i < 4; ++i) {
+        fscl_lazy_erase(&saved[i]);
+        fscl_lazy_erase(&loaded[i]);
+    }
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_lazy_format_group) {
+    XTEST_RUN_UNIT(test_lazy_format_values);
+    XTEST_RUN_UNIT(test_lazy_format_sink);
+    XTEST_RUN_UNIT(test_lazy_format_snapshot);
+} // end of function main
@@ -0,0 +1,73 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/lazy_future.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+// Sum 1..n the slow way so the worker has something to do
+static void slow_sum(clazy* lazy, void* context) {
+    int n = *(int*)context;
+    int total = 0;
+    for (int i = 1; i <= n; ++i) {
+        total += i;
+    }
+    fscl_lazy_set_int(lazy, total);
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_lazy_future_spawn_force) {
+    int n = 1000;
+    clazy lazy = fscl_lazy_create_thunk(CLAZY_INT, slow_sum, &n);
+    fscl_lazy_spawn(&lazy);
+    TEST_ASSERT_EQUAL_INT(500500, fscl_lazy_force_int(&lazy));
+    fscl_lazy_erase(&lazy);
+}
+
+XTEST_CASE(test_lazy_future_try_force) {
+    int n = 100;
+    clazy lazy = fscl_lazy_create_thunk(CLAZY_INT, slow_sum, &n);
+    while (!fscl_lazy_try_force(&lazy)) {
+        // Keep polling until the worker has finished
+    }
+    TEST_ASSERT_EQUAL_INT(5050, fscl_lazy_force_int(&lazy));
+    fscl_lazy_erase(&lazy);
+}
+
+XTEST_CASE(test_lazy_future_when_all) {
+    int counts[4] = {10, 20, 30, 40};
+    clazy lazies[4];
+    clazy* set[4];
+    for (int i = 0; i < 4; ++i) {
+        lazies[i] = fscl_lazy_create_thunk(CLAZY_INT, slow_sum, &counts[i]);
+        set[i] = &lazies[i];
+    }
+
+    fscl_lazy_when_all(set, 4);
+    for (int i = 0; i < 4; ++i) {
+        TEST_ASSERT_TRUE(fscl_lazy_try_force(&lazies[i]));
+        TEST_ASSERT_EQUAL_INT(counts[i] * (counts[i] + 1) / 2, fscl_lazy_force_int(&lazies[i]));
+        fscl_lazy_erase(&lazies[i]);
+    }
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_lazy_future_group) {
+    XTEST_RUN_UNIT(test_lazy_future_spawn_force);
+    XTEST_RUN_UNIT(test_lazy_future_try_force);
+    XTEST_RUN_UNIT(test_lazy_future_when_all);
+} // end of function main
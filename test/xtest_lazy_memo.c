@@ -0,0 +1,97 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/lazy_memo.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include <string.h>
+
+static int square_calls = 0;
+
+static int square(int value) {
+    square_calls++;
+    return value * value;
+}
+
+static const char* shout(const char* value) {
+    static char buffer[32];
+    size_t i = 0;
+    for (; value[i] != '\0' && i < sizeof(buffer) - 1; ++i) {
+        buffer[i] = (value[i] >= 'a' && value[i] <= 'z') ? (char)(value[i] - 32) : value[i];
+    }
+    buffer[i] = '\0';
+    return buffer;
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_lazy_memo_int_hits) {
+    clazy_memo memo;
+    TEST_ASSERT_TRUE(fscl_lazy_memo_create_int(&memo, square, 16, false));
+
+    square_calls = 0;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            TEST_ASSERT_EQUAL_INT(i * i, fscl_lazy_memo_apply_int(&memo, i));
+        }
+    }
+
+    clazy_memo_stats stats = fscl_lazy_memo_stats(&memo);
+    TEST_ASSERT_EQUAL_INT(4, square_calls);
+    TEST_ASSERT_EQUAL_INT(4, stats.misses);
+    TEST_ASSERT_EQUAL_INT(8, stats.hits);
+    fscl_lazy_memo_erase(&memo);
+}
+
+XTEST_CASE(test_lazy_memo_int_eviction) {
+    clazy_memo memo;
+    TEST_ASSERT_TRUE(fscl_lazy_memo_create_int(&memo, square, 4, true));
+
+    for (int i = 0; i < 100; ++i) {
+        TEST_ASSERT_EQUAL_INT(i * i, fscl_lazy_memo_apply_int(&memo, i));
+    }
+
+    clazy_memo_stats stats = fscl_lazy_memo_stats(&memo);
+    TEST_ASSERT_EQUAL_INT(4, stats.size);
+    TEST_ASSERT_EQUAL_INT(96, stats.evictions);
+    TEST_ASSERT_EQUAL_INT(99 * 99, fscl_lazy_memo_apply_int(&memo, 99));
+    fscl_lazy_memo_erase(&memo);
+}
+
+XTEST_CASE(test_lazy_memo_map_cstring) {
+    clazy_memo memo;
+    TEST_ASSERT_TRUE(fscl_lazy_memo_create_cstring(&memo, shout, 8, false));
+
+    for (int i = 0; i < 2; ++i) {
+        clazy text = fscl_lazy_create(CLAZY_STRING);
+        fscl_lazy_set_cstring(&text, "hello");
+        fscl_lazy_memo_map_cstring(&memo, &text);
+        TEST_ASSERT_TRUE(strcmp("HELLO", fscl_lazy_force_string(&text)) == 0);
+        fscl_lazy_erase(&text);
+    }
+
+    clazy_memo_stats stats = fscl_lazy_memo_stats(&memo);
+    TEST_ASSERT_EQUAL_INT(1, stats.misses);
+    TEST_ASSERT_EQUAL_INT(1, stats.hits);
+    fscl_lazy_memo_erase(&memo);
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_lazy_memo_group) {
+    XTEST_RUN_UNIT(test_lazy_memo_int_hits);
+    XTEST_RUN_UNIT(test_lazy_memo_int_eviction);
+    XTEST_RUN_UNIT(test_lazy_memo_map_cstring);
+} // end of function main
@@ -0,0 +1,139 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/lazy_reduce.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include <limits.h>
+#include <stdlib.h>
+
+#define REDUCE_COUNT 10000
+
+// Element i of the stream is i - 5000
+static void centered(clazy* out, size_t index, void* context) {
+    (void)context;
+    fscl_lazy_set_int(out, (int)index - 5000);
+}
+
+static bool is_even(clazy* item) {
+    return item->cache.memoized_int % 2 == 0;
+}
+
+static void longest_init(void* accumulator, void* context) {
+    (void)context;
+    *(size_t*)accumulator = 0;
+}
+
+static void longest_step(void* accumulator, clazy* item, void* context) {
+    (void)context;
+    size_t value = (size_t)abs(item->cache.memoized_int);
+    if (value > *(size_t*)accumulator) {
+        *(size_t*)accumulator = value;
+    }
+}
+
+static void longest_combine(void* accumulator, const void* partial, void* context) {
+    (void)context;
+    if (*(const size_t*)partial > *(size_t*)accumulator) {
+        *(size_t*)accumulator = *(const size_t*)partial;
+    }
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_lazy_reduce_array) {
+    clazy* items = malloc(REDUCE_COUNT * sizeof(clazy));
+    TEST_ASSERT_NOT_CNULLPTR(items);
+    for (int i = 0; i < REDUCE_COUNT; ++i) {
+        items[i] = fscl_lazy_create(CLAZY_INT);
+        fscl_lazy_set_int(&items[i], i + 1);
+    }
+
+    for (size_t threads = 0; threads <= 4; threads += 4) {
+        int low = 0, high = 0;
+        TEST_ASSERT_EQUAL_INT(50005000LL, fscl_lazy_sum_int(items, REDUCE_COUNT, threads));
+        TEST_ASSERT_TRUE(fscl_lazy_min_int(items, REDUCE_COUNT, threads, &low));
+        TEST_ASSERT_TRUE(fscl_lazy_max_int(items, REDUCE_COUNT, threads, &high));
+        TEST_ASSERT_EQUAL_INT(1, low);
+        TEST_ASSERT_EQUAL_INT(REDUCE_COUNT, high);
+        TEST_ASSERT_EQUAL_INT(REDUCE_COUNT / 2, fscl_lazy_count_if(items, REDUCE_COUNT, is_even, threads));
+    }
+
+    int unused = 0;
+    TEST_ASSERT_FALSE(fscl_lazy_min_int(items, 0, 1, &unused));
+    free(items);
+}
+
+XTEST_CASE(test_lazy_reduce_extremes) {
+    // Odd length so the vector kernels also run their scalar tails
+    enum { COUNT = 1003 };
+    clazy* items = malloc(COUNT * sizeof(clazy));
+    TEST_ASSERT_NOT_CNULLPTR(items);
+    unsigned state = 12345;
+    long long expected_sum = 0;
+    int expected_min = INT_MAX, expected_max = INT_MIN;
+    for (int i = 0; i < COUNT; ++i) {
+        state = state * 1103515245u + 12345u;
+        int value = (int)(state >> 1) - (1 << 30);
+        if (i == 517) {
+            value = INT_MIN;
+        } else if (i == COUNT - 1) {
+            value = INT_MAX;
+        }
+        items[i] = fscl_lazy_create(CLAZY_INT);
+        fscl_lazy_set_int(&items[i], value);
+        expected_sum += value;
+        expected_min = value < expected_min ? value : expected_min;
+        expected_max = value > expected_max ? value : expected_max;
+    }
+
+    int low = 0, high = 0;
+    TEST_ASSERT_TRUE(fscl_lazy_sum_int(items, COUNT, 1) == expected_sum);
+    TEST_ASSERT_TRUE(fscl_lazy_min_int(items, COUNT, 1, &low));
+    TEST_ASSERT_TRUE(fscl_lazy_max_int(items, COUNT, 1, &high));
+    TEST_ASSERT_EQUAL_INT(expected_min, low);
+    TEST_ASSERT_EQUAL_INT(expected_max, high);
+    free(items);
+}
+
+XTEST_CASE(test_lazy_reduce_stream) {
+    clazy_stream stream = fscl_lazy_stream_create(CLAZY_INT, centered, NULL, REDUCE_COUNT);
+    int low = 0, high = 0;
+
+    TEST_ASSERT_EQUAL_INT(-5000, fscl_lazy_stream_sum_int(&stream, 0));
+    TEST_ASSERT_TRUE(fscl_lazy_stream_min_int(&stream, 3, &low));
+    TEST_ASSERT_TRUE(fscl_lazy_stream_max_int(&stream, 1, &high));
+    TEST_ASSERT_EQUAL_INT(-5000, low);
+    TEST_ASSERT_EQUAL_INT(4999, high);
+    TEST_ASSERT_EQUAL_INT(REDUCE_COUNT / 2, fscl_lazy_stream_count_if(&stream, is_even, 0));
+}
+
+XTEST_CASE(test_lazy_reduce_fold) {
+    clazy_stream stream = fscl_lazy_stream_create(CLAZY_INT, centered, NULL, REDUCE_COUNT);
+    clazy_fold fold = { sizeof(size_t), longest_init, longest_step, longest_combine, NULL };
+    size_t longest = 0;
+
+    fscl_lazy_stream_fold(&stream, &fold, &longest, 0);
+    TEST_ASSERT_EQUAL_INT(5000, longest);
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_lazy_reduce_group) {
+    XTEST_RUN_UNIT(test_lazy_reduce_array);
+    XTEST_RUN_UNIT(test_lazy_reduce_extremes);
+    XTEST_RUN_UNIT(test_lazy_reduce_stream);
+    XTEST_RUN_UNIT(test_lazy_reduce_fold);
+} // end of function main
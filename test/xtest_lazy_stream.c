@@ -0,0 +1,90 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/lazy_stream.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+#define STREAM_COUNT 1000
+
+// Element i of the stream is i * i
+static void squares(clazy* out, size_t index, void* context) {
+    (void)context;
+    fscl_lazy_set_int(out, (int)(index * index));
+}
+
+// Element i of the stream is the string "item"
+static void labels(clazy* out, size_t index, void* context) {
+    (void)index;
+    (void)context;
+    fscl_lazy_set_cstring(out, "item");
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_lazy_prefetch_order) {
+    clazy_stream stream = fscl_lazy_stream_create(CLAZY_INT, squares, NULL, STREAM_COUNT);
+    clazy_prefetch prefetch;
+    clazy item;
+    size_t seen = 0;
+    bool ordered = true;
+
+    TEST_ASSERT_TRUE(fscl_lazy_prefetch_create(&prefetch, &stream, 3));
+    TEST_ASSERT_EQUAL_INT(4, prefetch.depth);
+    while (fscl_lazy_prefetch_next(&prefetch, &item)) {
+        ordered = ordered && fscl_lazy_force_int(&item) == (int)(seen * seen);
+        fscl_lazy_erase(&item);
+        seen++;
+    }
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_EQUAL_INT(STREAM_COUNT, seen);
+    TEST_ASSERT_FALSE(fscl_lazy_prefetch_next(&prefetch, &item));
+    fscl_lazy_prefetch_erase(&prefetch);
+}
+
+XTEST_CASE(test_lazy_prefetch_cancel) {
+    clazy_stream stream = fscl_lazy_stream_create(CLAZY_STRING, labels, NULL, STREAM_COUNT);
+    clazy_prefetch prefetch;
+    clazy item;
+
+    TEST_ASSERT_TRUE(fscl_lazy_prefetch_create(&prefetch, &stream, 8));
+    for (int i = 0; i < 10; ++i) {
+        TEST_ASSERT_TRUE(fscl_lazy_prefetch_next(&prefetch, &item));
+        fscl_lazy_erase(&item);
+    }
+
+    // Unconsumed strings are released by erase
+    fscl_lazy_prefetch_cancel(&prefetch);
+    TEST_ASSERT_FALSE(fscl_lazy_prefetch_next(&prefetch, &item));
+    fscl_lazy_prefetch_erase(&prefetch);
+}
+
+XTEST_CASE(test_lazy_prefetch_empty) {
+    clazy_stream stream = fscl_lazy_stream_create(CLAZY_INT, squares, NULL, 0);
+    clazy_prefetch prefetch;
+    clazy item;
+
+    TEST_ASSERT_TRUE(fscl_lazy_prefetch_create(&prefetch, &stream, 0));
+    TEST_ASSERT_FALSE(fscl_lazy_prefetch_next(&prefetch, &item));
+    fscl_lazy_prefetch_erase(&prefetch);
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_lazy_stream_group) {
+    XTEST_RUN_UNIT(test_lazy_prefetch_order);
+    XTEST_RUN_UNIT(test_lazy_prefetch_cancel);
+    XTEST_RUN_UNIT(test_lazy_prefetch_empty);
+} // end of function main
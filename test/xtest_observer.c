@@ -15,6 +15,39 @@ Description:
 #include <fossil/xtest.h>   // basic test tools
 #include <fossil/xassert.h> // extra asserts
 
+typedef struct {
+    int builds;
+    int destroys;
+    int seen;
+} payload_counts;
+
+static payload_counts counts;
+
+static void* build_payload(void* context) {
+    counts.builds++;
+    int* value = malloc(sizeof(int));
+    *value = *(int*)context;
+    return value;
+}
+
+static void destroy_payload(void* payload, void* context) {
+    (void)context;
+    counts.destroys++;
+    free(payload);
+}
+
+static void ignore_payload(cpayload* payload) {
+    (void)payload;
+}
+
+static void read_payload(cpayload* payload) {
+    counts.seen += *(int*)fscl_observe_payload_get(payload);
+}
+
+static void read_data(void* data) {
+    counts.seen += *(int*)data;
+}
+
 //
 // XUNIT TEST CASES
 //
@@ -49,10 +82,68 @@ XTEST_CASE(test_erase_all_observers) {
     TEST_ASSERT_EQUAL_INT(0, subject.numObservers);
 }
 
+// Observers set up the pre-lazy way leave everything but update untouched
+XTEST_CASE(test_notify_lazy_plain_observer) {
+    csubject subject;
+    cobserver observer;
+    int value = 4;
+    observer.update = read_data;
+    fscl_observe_create(&subject);
+    counts = (payload_counts){ 0, 0, 0 };
+
+    fscl_observe_add_observer(&subject, &observer);
+    fscl_observe_notify_lazy(&subject, build_payload, destroy_payload, &value);
+    TEST_ASSERT_EQUAL_INT(1, counts.builds);
+    TEST_ASSERT_EQUAL_INT(1, counts.destroys);
+    TEST_ASSERT_EQUAL_INT(4, counts.seen);
+
+    fscl_observe_erase(&subject);
+}
+
+XTEST_CASE(test_notify_lazy_payload) {
+    csubject subject;
+    int value = 5;
+    fscl_observe_create(&subject);
+    counts = (payload_counts){ 0, 0, 0 };
+
+    // Nobody observes, so nothing is built
+    fscl_observe_notify_lazy(&subject, build_payload, destroy_payload, &value);
+    TEST_ASSERT_EQUAL_INT(0, counts.builds);
+
+    // Uninterested observers never build the payload
+    cpayload_observer quiet = { { NULL }, ignore_payload };
+    fscl_observe_add_lazy_observer(&subject, &quiet);
+    fscl_observe_notify_lazy(&subject, build_payload, destroy_payload, &value);
+    TEST_ASSERT_EQUAL_INT(0, counts.builds);
+
+    // Every reader shares one payload, destroyed after the notification
+    cpayload_observer lazy_reader = { { NULL }, read_payload };
+    cobserver eager_reader = { read_data };
+    fscl_observe_add_lazy_observer(&subject, &lazy_reader);
+    fscl_observe_add_observer(&subject, &eager_reader);
+    fscl_observe_notify_lazy(&subject, build_payload, destroy_payload, &value);
+    TEST_ASSERT_EQUAL_INT(1, counts.builds);
+    TEST_ASSERT_EQUAL_INT(1, counts.destroys);
+    TEST_ASSERT_EQUAL_INT(10, counts.seen);
+
+    // Plain notifications reach lazy observers as an already built payload
+    fscl_observe_notify(&subject, &value);
+    TEST_ASSERT_EQUAL_INT(1, counts.builds);
+    TEST_ASSERT_EQUAL_INT(20, counts.seen);
+
+    fscl_observe_remove_lazy_observer(&subject, &lazy_reader);
+    fscl_observe_remove_lazy_observer(&subject, &quiet);
+    TEST_ASSERT_EQUAL_INT(1, subject.numObservers);
+
+    fscl_observe_erase(&subject);
+}
+
 //
 // XUNIT-TEST RUNNER
 //
 XTEST_DEFINE_POOL(test_observe_group) {
     XTEST_RUN_UNIT(test_create_and_add_observer);
     XTEST_RUN_UNIT(test_erase_all_observers);
+    XTEST_RUN_UNIT(test_notify_lazy_plain_observer);
+    XTEST_RUN_UNIT(test_notify_lazy_payload);
 } // end of function main
@@ -0,0 +1,139 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/observer_typed.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+typedef struct {
+    int id;
+    double readings[16];
+} sample_event;
+
+FSCL_OBSERVE_DECLARE(sample, sample_event)
+FSCL_OBSERVE_DECLARE_FIXED_VALUE(level, int, 2)
+
+static void on_sample(void* context, const sample_event* event) {
+    *(int*)context += event->id;
+}
+
+static void on_level(void* context, int value) {
+    *(int*)context += value;
+}
+
+static void on_level_twice(void* context, int value) {
+    *(int*)context += 2 * value;
+}
+
+// Changes the subject it is notified by
+typedef struct {
+    sample_subject* subject;
+    int calls;
+    int added;
+} sample_mutator;
+
+static void on_sample_count(void* context, const sample_event* event) {
+    (void)event;
+    ((sample_mutator*)context)->calls++;
+}
+
+static void on_sample_add(void* context, const sample_event* event) {
+    sample_mutator* mutator = context;
+    (void)event;
+    mutator->calls++;
+    // Enough to reallocate the observer array mid-notify
+    for (int i = 0; i < 8; ++i) {
+        sample_add(mutator->subject, on_sample_count, mutator);
+        mutator->added++;
+    }
+    sample_remove(mutator->subject, on_sample_add, mutator);
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_observer_typed_heap) {
+    sample_subject subject;
+    int totals[8] = { 0 };
+    sample_create(&subject);
+    TEST_ASSERT_FALSE(sample_has_observers(&subject));
+
+    for (int i = 0; i < 8; ++i) {
+        TEST_ASSERT_TRUE(sample_add(&subject, on_sample, &totals[i]));
+    }
+    sample_event event = { 3, { 0 } };
+    sample_notify(&subject, &event);
+    TEST_ASSERT_EQUAL_INT(3, totals[0]);
+    TEST_ASSERT_EQUAL_INT(3, totals[7]);
+
+    TEST_ASSERT_TRUE(sample_remove(&subject, on_sample, &totals[0]));
+    TEST_ASSERT_FALSE(sample_remove(&subject, on_sample, &totals[0]));
+    sample_notify(&subject, &event);
+    TEST_ASSERT_EQUAL_INT(3, totals[0]);
+    TEST_ASSERT_EQUAL_INT(6, totals[1]);
+    TEST_ASSERT_EQUAL_INT(7, (int)subject.count);
+
+    sample_erase(&subject);
+    TEST_ASSERT_FALSE(sample_has_observers(&subject));
+}
+
+XTEST_CASE(test_observer_typed_reentrant) {
+    sample_subject subject;
+    sample_mutator mutator = { &subject, 0, 0 };
+    sample_mutator tail = { &subject, 0, 0 };
+    sample_event event = { 1, { 0 } };
+    sample_create(&subject);
+    TEST_ASSERT_TRUE(sample_add(&subject, on_sample_add, &mutator));
+    TEST_ASSERT_TRUE(sample_add(&subject, on_sample_count, &tail));
+
+    // The adding observer removes itself, so the tail moves into its slot
+    // and is skipped this round; the eight new observers are all reached
+    sample_notify(&subject, &event);
+    TEST_ASSERT_EQUAL_INT(1 + 8, mutator.calls);
+    TEST_ASSERT_EQUAL_INT(0, tail.calls);
+    TEST_ASSERT_EQUAL_INT(9, (int)subject.count);
+
+    // Each observer is now notified exactly once
+    sample_notify(&subject, &event);
+    TEST_ASSERT_EQUAL_INT(1 + 8 + 8, mutator.calls);
+    TEST_ASSERT_EQUAL_INT(1, tail.calls);
+    sample_erase(&subject);
+}
+
+XTEST_CASE(test_observer_typed_fixed) {
+    level_subject subject;
+    int total = 0;
+    level_create(&subject);
+    TEST_ASSERT_TRUE(level_add(&subject, on_level, &total));
+    TEST_ASSERT_TRUE(level_add(&subject, on_level_twice, &total));
+    TEST_ASSERT_FALSE(level_add(&subject, on_level, &total));
+
+    level_notify(&subject, 5);
+    TEST_ASSERT_EQUAL_INT(15, total);
+
+    // Observers are told apart by callback and context
+    TEST_ASSERT_TRUE(level_remove(&subject, on_level, &total));
+    level_notify(&subject, 1);
+    TEST_ASSERT_EQUAL_INT(17, total);
+    level_erase(&subject);
+    TEST_ASSERT_FALSE(level_has_observers(&subject));
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_observer_typed_group) {
+    XTEST_RUN_UNIT(test_observer_typed_heap);
+    XTEST_RUN_UNIT(test_observer_typed_reentrant);
+    XTEST_RUN_UNIT(test_observer_typed_fixed);
+} // end of function main
@@ -0,0 +1,132 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xpattern/trace.h" // lib source code
+#include "fossil/xpattern/contract.h"
+#include "fossil/xpattern/lazy.h"
+#include "fossil/xpattern/observer.h"
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_TEST_CAPACITY 64
+
+static void trace_noop(void* data) {
+    (void)data;
+}
+
+// Events of one kind carrying the given first argument, oldest first
+static size_t trace_find(const ctrace_record* records, size_t count, uint64_t arg0, ctrace_record* out) {
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (records[i].arg0 == arg0) {
+            out[found++] = records[i];
+        }
+    }
+    return found;
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_trace_user_events) {
+    ctrace_record records[TRACE_TEST_CAPACITY];
+    fscl_trace_clear();
+    for (uint64_t i = 0; i < 3; ++i) {
+        fscl_trace_record(CTRACE_USER, 0x7ace, i);
+    }
+    fscl_trace_enable(false);
+    fscl_trace_record(CTRACE_USER, 0x7ace, 99);
+    fscl_trace_enable(true);
+
+    ctrace_record mine[TRACE_TEST_CAPACITY];
+    size_t count = fscl_trace_snapshot(records, TRACE_TEST_CAPACITY);
+    TEST_ASSERT_EQUAL_INT(3, (int)trace_find(records, count, 0x7ace, mine));
+    for (int i = 0; i < 3; ++i) {
+        TEST_ASSERT_EQUAL_INT(CTRACE_USER, (int)mine[i].event);
+        TEST_ASSERT_EQUAL_INT(i, (int)mine[i].arg1);
+        TEST_ASSERT_TRUE(mine[i].thread == mine[0].thread);
+    }
+    TEST_ASSERT_TRUE(mine[0].time_ns <= mine[2].time_ns);
+
+    fscl_trace_clear();
+    TEST_ASSERT_EQUAL_INT(0, (int)trace_find(records, fscl_trace_snapshot(records, TRACE_TEST_CAPACITY), 0x7ace, mine));
+}
+
+XTEST_CASE(test_trace_dump) {
+    const char* path = "xtest_trace.ftrc";
+    fscl_trace_clear();
+    fscl_trace_record(CTRACE_USER + 1, 1, 2);
+    TEST_ASSERT_TRUE(fscl_trace_dump(path));
+
+    FILE* file = fopen(path, "rb");
+    TEST_ASSERT_NOT_CNULLPTR(file);
+    char magic[4];
+    uint32_t header[3];
+    TEST_ASSERT_TRUE(fread(magic, 1, 4, file) == 4);
+    TEST_ASSERT_TRUE(fread(header, sizeof(header), 1, file) == 1);
+    TEST_ASSERT_TRUE(memcmp(magic, "FTRC", 4) == 0);
+    TEST_ASSERT_EQUAL_INT(1, (int)header[0]);
+    TEST_ASSERT_EQUAL_INT((int)sizeof(ctrace_record), (int)header[1]);
+    TEST_ASSERT_TRUE(header[2] >= 1);
+    fclose(file);
+    remove(path);
+}
+
+XTEST_CASE(test_trace_probes) {
+    if (fscl_trace_mode() != FSCL_TRACE_RING) {
+        return;
+    }
+    ctrace_record records[TRACE_TEST_CAPACITY];
+    ctrace_record mine[TRACE_TEST_CAPACITY];
+    csubject subject;
+    cobserver observers[2] = { { trace_noop }, { trace_noop } };
+    fscl_observe_create(&subject);
+    fscl_observe_add_observer(&subject, &observers[0]);
+    fscl_observe_add_observer(&subject, &observers[1]);
+
+    fscl_trace_clear();
+    fscl_observe_notify(&subject, NULL);
+    size_t count = fscl_trace_snapshot(records, TRACE_TEST_CAPACITY);
+    TEST_ASSERT_EQUAL_INT(4, (int)trace_find(records, count, (uint64_t)(uintptr_t)&subject, mine));
+    TEST_ASSERT_EQUAL_INT(CTRACE_NOTIFY_BEGIN, (int)mine[0].event);
+    TEST_ASSERT_EQUAL_INT(CTRACE_OBSERVER_DISPATCH, (int)mine[1].event);
+    TEST_ASSERT_TRUE(mine[2].arg1 == (uint64_t)(uintptr_t)&observers[1]);
+    TEST_ASSERT_EQUAL_INT(CTRACE_NOTIFY_END, (int)mine[3].event);
+    fscl_observe_erase(&subject);
+
+    clazy lazy = fscl_lazy_create(CLAZY_INT);
+    fscl_lazy_force(&lazy);
+    fscl_lazy_force(&lazy);
+    count = fscl_trace_snapshot(records, TRACE_TEST_CAPACITY);
+    TEST_ASSERT_EQUAL_INT(2, (int)trace_find(records, count, (uint64_t)(uintptr_t)&lazy, mine));
+    TEST_ASSERT_EQUAL_INT(CTRACE_LAZY_FORCE_BEGIN, (int)mine[0].event);
+    TEST_ASSERT_EQUAL_INT(CTRACE_LAZY_FORCE_END, (int)mine[1].event);
+
+    const char* message = "trace probe";
+    fscl_contract_assert(false, message);
+    count = fscl_trace_snapshot(records, TRACE_TEST_CAPACITY);
+    TEST_ASSERT_EQUAL_INT(1, (int)trace_find(records, count, (uint64_t)(uintptr_t)message, mine));
+    TEST_ASSERT_EQUAL_INT(CTRACE_CONTRACT_VIOLATION, (int)mine[0].event);
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_trace_group) {
+    XTEST_RUN_UNIT(test_trace_user_events);
+    XTEST_RUN_UNIT(test_trace_dump);
+    XTEST_RUN_UNIT(test_trace_probes);
+} // end of function main
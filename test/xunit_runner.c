@@ -17,7 +17,21 @@ Description:
 //
 XTEST_EXTERN_POOL(test_observe_group);
 XTEST_EXTERN_POOL(test_lazy_group);
+XTEST_EXTERN_POOL(test_lazy_memo_group);
+XTEST_EXTERN_POOL(test_lazy_future_group);
+XTEST_EXTERN_POOL(test_lazy_expire_group);
+XTEST_EXTERN_POOL(test_lazy_reduce_group);
+XTEST_EXTERN_POOL(test_lazy_format_group);
+XTEST_EXTERN_POOL(test_lazy_stream_group);
 XTEST_EXTERN_POOL(test_contract_group);
+XTEST_EXTERN_POOL(test_contract_report_group);
+XTEST_EXTERN_POOL(test_contract_sample_group);
+XTEST_EXTERN_POOL(test_contract_span_group);
+XTEST_EXTERN_POOL(test_contract_set_group);
+XTEST_EXTERN_POOL(test_alloc_group);
+XTEST_EXTERN_POOL(test_trace_group);
+XTEST_EXTERN_POOL(test_inline_group);
+XTEST_EXTERN_POOL(test_observer_typed_group);
 
 //
 // XUNIT-TEST RUNNER
@@ -27,7 +41,21 @@ int main(int argc, char **argv) {
 
     XTEST_IMPORT_POOL(test_observe_group);
     XTEST_IMPORT_POOL(test_lazy_group);
+    XTEST_IMPORT_POOL(test_lazy_memo_group);
+    XTEST_IMPORT_POOL(test_lazy_future_group);
+    XTEST_IMPORT_POOL(test_lazy_expire_group);
+    XTEST_IMPORT_POOL(test_lazy_reduce_group);
+    XTEST_IMPORT_POOL(test_lazy_format_group);
+    XTEST_IMPORT_POOL(test_lazy_stream_group);
     XTEST_IMPORT_POOL(test_contract_group);
+    XTEST_IMPORT_POOL(test_contract_report_group);
+    XTEST_IMPORT_POOL(test_contract_sample_group);
+    XTEST_IMPORT_POOL(test_contract_span_group);
+    XTEST_IMPORT_POOL(test_contract_set_group);
+    XTEST_IMPORT_POOL(test_alloc_group);
+    XTEST_IMPORT_POOL(test_trace_group);
+    XTEST_IMPORT_POOL(test_inline_group);
+    XTEST_IMPORT_POOL(test_observer_typed_group);
 
     return XTEST_ERASE();
 } // end of func